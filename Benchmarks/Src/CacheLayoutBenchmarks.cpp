@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "DataStructures/ConcurrentBlockQueue.hpp"
+#include "DataStructures/ConcurrentHashMap.hpp"
+#include "Utilities/CacheLine.hpp"
+#include "Utilities/Mutex.hpp"
+#include "Utilities/SpinLock.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+/*
+ *  stress loops where threads touch neighbouring but unrelated state. meant to be run
+ *  under `perf c2c record -- threading_library_benchmarks --benchmark_filter=CacheLayout`
+ *  and compared with `perf c2c report --stats` of a build without the padding: HITM
+ *  events on the container lines are false sharing.
+ */
+namespace
+{
+    constexpr size_t max_threads = 8;
+    constexpr size_t map_buckets = 1031;
+    constexpr int64_t queue_backlog = 4096;
+    constexpr int64_t tasks_per_iteration = 4096;
+
+    // the layout SpinLock had before it was padded, as the in-build baseline
+    struct PackedSpinLock
+    {
+        std::atomic<bool> locked{false};
+
+        void lock()
+        {
+            while (locked.load(std::memory_order_relaxed) || locked.exchange(true, std::memory_order_acquire))
+                Utilities::cpu_relax();
+        }
+
+        void unlock()
+        {
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+    // every thread takes only its own lock, any slowdown with more threads is false sharing
+    template<typename Lock>
+    void private_locks(benchmark::State& state)
+    {
+        static std::array<Lock, max_threads> locks;
+        static std::array<Utilities::CachePadded<int64_t>, max_threads> counters;
+
+        const auto index = static_cast<size_t>(state.thread_index());
+        for (auto _ : state)
+        {
+            std::lock_guard<Lock> guard(locks[index]);
+            ++counters[index].value;
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+}  // namespace
+
+static void BM_CacheLayoutPackedSpinLocks(benchmark::State& state)
+{
+    private_locks<PackedSpinLock>(state);
+}
+BENCHMARK(BM_CacheLayoutPackedSpinLocks)->ThreadRange(1, max_threads)->UseRealTime();
+
+static void BM_CacheLayoutSpinLocks(benchmark::State& state)
+{
+    private_locks<Utilities::SpinLock>(state);
+}
+BENCHMARK(BM_CacheLayoutSpinLocks)->ThreadRange(1, max_threads)->UseRealTime();
+
+// thread 0 pushes, thread 1 pops: head and tail are only shared through the published count
+static void BM_CacheLayoutBlockQueue(benchmark::State& state)
+{
+    static std::unique_ptr<DataStructures::ConcurrentBlockQueue<int64_t>> queue;
+    if (state.thread_index() == 0)
+        queue = std::make_unique<DataStructures::ConcurrentBlockQueue<int64_t>>();
+
+    const bool producer = state.thread_index() == 0;
+    int64_t moved = 0;
+
+    for (auto _ : state)
+    {
+        if (producer)
+        {
+            if (queue->was_size() < static_cast<size_t>(queue_backlog))
+            {
+                queue->push(int64_t{moved});
+                ++moved;
+            }
+        }
+        else if (auto value = queue->try_pop())
+        {
+            benchmark::DoNotOptimize(*value);
+            ++moved;
+        }
+    }
+
+    if (state.thread_index() == 0)
+        queue.reset();
+
+    state.SetItemsProcessed(moved);
+}
+BENCHMARK(BM_CacheLayoutBlockQueue)->Threads(2)->UseRealTime();
+
+// thread t only uses keys of bucket t, neighbouring buckets belong to different threads
+static void BM_CacheLayoutHashMap(benchmark::State& state)
+{
+    using Map = DataStructures::ConcurrentHashMap<int64_t, int64_t, std::hash<int64_t>, map_buckets>;
+
+    static std::unique_ptr<Map> map;
+    if (state.thread_index() == 0)
+        map = std::make_unique<Map>();
+
+    const auto bucket = static_cast<int64_t>(state.thread_index());
+    int64_t round = 0;
+
+    for (auto _ : state)
+    {
+        const auto key = bucket + static_cast<int64_t>(map_buckets) * (round++ % 64);
+        map->insert(int64_t{key}, int64_t{key});
+        benchmark::DoNotOptimize(map->remove(key));
+    }
+
+    if (state.thread_index() == 0)
+        map.reset();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CacheLayoutHashMap)->ThreadRange(1, max_threads)->UseRealTime();
+
+// posts small tasks from outside the pool: workers pop while the submitter pushes
+static void BM_CacheLayoutThreadPool(benchmark::State& state)
+{
+    Utilities::ThreadPool pool(static_cast<size_t>(state.range(0)));
+    Utilities::CachePadded<std::atomic<int64_t>> finished;
+
+    for (auto _ : state)
+    {
+        finished.value.store(0, std::memory_order_relaxed);
+        for (int64_t i = 0; i < tasks_per_iteration; ++i)
+            pool.post(
+                [&finished]() noexcept
+                {
+                    if (finished.value.fetch_add(1, std::memory_order_acq_rel) + 1 == tasks_per_iteration)
+                        finished.value.notify_one();
+                });
+
+        for (auto done = finished.value.load(std::memory_order_acquire); done != tasks_per_iteration;
+             done = finished.value.load(std::memory_order_acquire))
+            finished.value.wait(done, std::memory_order_acquire);
+    }
+
+    state.SetItemsProcessed(state.iterations() * tasks_per_iteration);
+}
+BENCHMARK(BM_CacheLayoutThreadPool)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "DataStructures/Channel.hpp"
+#include "DataStructures/ConcurrentBlockQueue.hpp"
+#include "DataStructures/SynchronizedQueue.hpp"
+
+namespace
+{
+    constexpr int64_t messages_per_iteration = 1 << 14;
+
+    // adapters so every queue runs the same ping-pong / fan-in loops
+    template<typename Channel>
+    struct ChannelEndpoint
+    {
+        Channel queue;
+
+        void put(int64_t value)
+        {
+            queue.send(std::move(value));
+        }
+
+        int64_t take()
+        {
+            return *queue.recv();
+        }
+    };
+
+    struct BlockQueueEndpoint
+    {
+        DataStructures::ConcurrentBlockQueue<int64_t> queue;
+
+        void put(int64_t value)
+        {
+            queue.push(std::move(value));
+        }
+
+        int64_t take()
+        {
+            return *queue.wait_and_pop();
+        }
+    };
+
+    struct SynchronizedQueueEndpoint
+    {
+        DataStructures::SynchronizedQueue<int64_t> queue;
+
+        void put(int64_t value)
+        {
+            queue.push(value);
+        }
+
+        int64_t take()
+        {
+            return queue.wait_and_pop();
+        }
+    };
+
+    // one message bounces between two threads, measures wake-up latency
+    template<typename Endpoint>
+    void ping_pong(benchmark::State& state)
+    {
+        Endpoint ping;
+        Endpoint pong;
+
+        std::jthread echo(
+            [&ping, &pong]()
+            {
+                for (int64_t value = ping.take(); value >= 0; value = ping.take())
+                    pong.put(value);
+            });
+
+        for (auto _ : state)
+        {
+            for (int64_t i = 0; i < messages_per_iteration; ++i)
+            {
+                ping.put(i);
+                benchmark::DoNotOptimize(pong.take());
+            }
+        }
+
+        ping.put(-1);
+        state.SetItemsProcessed(state.iterations() * messages_per_iteration);
+    }
+
+    // Arg producers into a single consumer, measures contended throughput
+    template<typename Endpoint>
+    void fan_in(benchmark::State& state)
+    {
+        const auto producers = state.range(0);
+        const auto per_producer = messages_per_iteration / producers;
+
+        for (auto _ : state)
+        {
+            Endpoint sink;
+            std::vector<std::jthread> threads;
+            for (int64_t p = 0; p < producers; ++p)
+                threads.emplace_back(
+                    [&sink, per_producer]()
+                    {
+                        for (int64_t i = 0; i < per_producer; ++i)
+                            sink.put(i);
+                    });
+
+            int64_t sum = 0;
+            for (int64_t i = 0; i < per_producer * producers; ++i)
+                sum += sink.take();
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * (per_producer * producers));
+    }
+}  // namespace
+
+static void BM_PingPongBoundedChannel(benchmark::State& state)
+{
+    ping_pong<ChannelEndpoint<DataStructures::Channel<int64_t, 1>>>(state);
+}
+BENCHMARK(BM_PingPongBoundedChannel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PingPongUnboundedChannel(benchmark::State& state)
+{
+    ping_pong<ChannelEndpoint<DataStructures::Channel<int64_t>>>(state);
+}
+BENCHMARK(BM_PingPongUnboundedChannel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PingPongBlockQueue(benchmark::State& state)
+{
+    ping_pong<BlockQueueEndpoint>(state);
+}
+BENCHMARK(BM_PingPongBlockQueue)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PingPongSynchronizedQueue(benchmark::State& state)
+{
+    ping_pong<SynchronizedQueueEndpoint>(state);
+}
+BENCHMARK(BM_PingPongSynchronizedQueue)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_FanInBoundedChannel(benchmark::State& state)
+{
+    fan_in<ChannelEndpoint<DataStructures::Channel<int64_t, 1024>>>(state);
+}
+BENCHMARK(BM_FanInBoundedChannel)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_FanInUnboundedChannel(benchmark::State& state)
+{
+    fan_in<ChannelEndpoint<DataStructures::Channel<int64_t>>>(state);
+}
+BENCHMARK(BM_FanInUnboundedChannel)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_FanInBlockQueue(benchmark::State& state)
+{
+    fan_in<BlockQueueEndpoint>(state);
+}
+BENCHMARK(BM_FanInBlockQueue)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_FanInSynchronizedQueue(benchmark::State& state)
+{
+    fan_in<SynchronizedQueueEndpoint>(state);
+}
+BENCHMARK(BM_FanInSynchronizedQueue)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "Utilities/Pipeline.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+namespace
+{
+    constexpr int64_t items_per_iteration = 1 << 12;
+
+    // stands in for parsing / transforming a record, roughly a microsecond
+    uint64_t mix(uint64_t value, const int rounds)
+    {
+        for (int i = 0; i < rounds; ++i)
+            value = (value ^ (value >> 31)) * 0x9e3779b97f4a7c15ULL;
+        return value;
+    }
+}  // namespace
+
+// read (serial) -> parse (parallel) -> transform (parallel) -> emit (serial, in order),
+// Arg = pool workers, two tokens per worker
+static void BM_PipelineFourStages(benchmark::State& state)
+{
+    const auto workers = static_cast<size_t>(state.range(0));
+    Utilities::ThreadPool pool(workers);
+
+    int64_t next = 0;
+    uint64_t checksum = 0;
+
+    auto pipeline = Utilities::make_pipeline(2 * workers,
+                                             [&next]() -> std::optional<uint64_t>
+                                             {
+                                                 if (next == items_per_iteration)
+                                                     return {};
+                                                 return static_cast<uint64_t>(next++);
+                                             })
+                        .then(Utilities::StageMode::Parallel, [](uint64_t value) noexcept { return mix(value, 200); })
+                        .then(Utilities::StageMode::Parallel, [](uint64_t value) noexcept { return mix(value, 100); })
+                        .sink(Utilities::StageMode::SerialInOrder,
+                              [&checksum](uint64_t value) noexcept { checksum = checksum * 31 + value; });
+
+    for (auto _ : state)
+    {
+        next = 0;
+        pipeline.run(pool);
+    }
+
+    benchmark::DoNotOptimize(checksum);
+    state.SetItemsProcessed(state.iterations() * items_per_iteration);
+}
+BENCHMARK(BM_PipelineFourStages)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
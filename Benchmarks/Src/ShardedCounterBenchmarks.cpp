@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "DataStructures/ConcurrentHashMap.hpp"
+#include "Utilities/ShardedCounter.hpp"
+
+namespace
+{
+    constexpr int64_t keys_per_thread = 4096;
+
+    template<typename Counter>
+    using CountedMap = DataStructures::
+        ConcurrentHashMap<int64_t, int64_t, std::hash<int64_t>, 1031, std::allocator<std::pair<const int64_t, int64_t>>, Counter>;
+
+    template<typename Counter>
+    void counter_increments(benchmark::State& state)
+    {
+        static std::unique_ptr<Counter> counter;
+        if (state.thread_index() == 0)
+            counter = std::make_unique<Counter>();
+
+        for (auto _ : state)
+            counter->increment();
+
+        if (state.thread_index() == 0)
+        {
+            benchmark::DoNotOptimize(counter->load());
+            counter.reset();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // every thread inserts and removes its own keys, so buckets barely collide and
+    // the size counter is the only line all threads write
+    template<typename Counter>
+    void map_insert_remove(benchmark::State& state)
+    {
+        static std::unique_ptr<CountedMap<Counter>> map;
+        if (state.thread_index() == 0)
+            map = std::make_unique<CountedMap<Counter>>();
+
+        const auto first_key = static_cast<int64_t>(state.thread_index()) * keys_per_thread;
+        int64_t offset = 0;
+
+        for (auto _ : state)
+        {
+            const auto key = first_key + offset;
+            offset = (offset + 1) % keys_per_thread;
+
+            map->insert(int64_t{key}, int64_t{key});
+            benchmark::DoNotOptimize(map->remove(key));
+        }
+
+        if (state.thread_index() == 0)
+            map.reset();
+
+        state.SetItemsProcessed(state.iterations());
+    }
+}  // namespace
+
+static void BM_CounterAtomic(benchmark::State& state)
+{
+    counter_increments<Utilities::AtomicCounter>(state);
+}
+BENCHMARK(BM_CounterAtomic)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_CounterSharded(benchmark::State& state)
+{
+    counter_increments<Utilities::ShardedCounter>(state);
+}
+BENCHMARK(BM_CounterSharded)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_MapInsertRemoveAtomicSize(benchmark::State& state)
+{
+    map_insert_remove<Utilities::AtomicCounter>(state);
+}
+BENCHMARK(BM_MapInsertRemoveAtomicSize)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_MapInsertRemoveShardedSize(benchmark::State& state)
+{
+    map_insert_remove<Utilities::ShardedCounter>(state);
+}
+BENCHMARK(BM_MapInsertRemoveShardedSize)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Utilities/Strand.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+namespace
+{
+    constexpr size_t updates_per_iteration = 1 << 16;
+
+    struct LockedEntity
+    {
+        std::mutex lock;
+        uint64_t value = 0;
+    };
+
+    struct StrandEntity
+    {
+        Utilities::Strand strand;
+        uint64_t value = 0;  // only touched from the strand
+
+        explicit StrandEntity(Utilities::ThreadPool& pool) noexcept
+            : strand(pool)
+        {
+        }
+    };
+
+    void wait_for(const std::atomic<size_t>& completed, const size_t expected)
+    {
+        while (completed.load(std::memory_order_acquire) < expected)
+            std::this_thread::yield();
+    }
+}  // namespace
+
+// per-entity updates serialized by a strand per entity, Arg = number of entities
+static void BM_StrandPerEntity(benchmark::State& state)
+{
+    Utilities::ThreadPool pool;
+    std::deque<StrandEntity> entities;
+    for (int64_t i = 0; i < state.range(0); ++i)
+        entities.emplace_back(pool);
+
+    std::atomic<size_t> completed{0};
+    size_t expected = 0;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < updates_per_iteration; ++i)
+        {
+            auto& entity = entities[i % entities.size()];
+            entity.strand.post(
+                [&entity, &completed]() noexcept
+                {
+                    ++entity.value;
+                    completed.fetch_add(1, std::memory_order_release);
+                });
+        }
+
+        expected += updates_per_iteration;
+        wait_for(completed, expected);
+    }
+
+    // ~Strand waits for the last drains to return before the entities go away
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(updates_per_iteration));
+}
+BENCHMARK(BM_StrandPerEntity)->Arg(16)->Arg(1024)->Arg(262144)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// the same updates as independent pool tasks guarded by a mutex per entity
+static void BM_MutexPerEntity(benchmark::State& state)
+{
+    Utilities::ThreadPool pool;
+    std::deque<LockedEntity> entities(static_cast<size_t>(state.range(0)));
+
+    std::atomic<size_t> completed{0};
+    size_t expected = 0;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < updates_per_iteration; ++i)
+        {
+            auto& entity = entities[i % entities.size()];
+            pool.post(
+                [&entity, &completed]() noexcept
+                {
+                    std::lock_guard<std::mutex> guard(entity.lock);
+                    ++entity.value;
+                    completed.fetch_add(1, std::memory_order_release);
+                });
+        }
+
+        expected += updates_per_iteration;
+        wait_for(completed, expected);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(updates_per_iteration));
+}
+BENCHMARK(BM_MutexPerEntity)->Arg(16)->Arg(1024)->Arg(262144)->Unit(benchmark::kMillisecond)->UseRealTime();
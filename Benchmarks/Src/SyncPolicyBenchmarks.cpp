@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "DataStructures/SynchronizedQueue.hpp"
+#include "Utilities/Mutex.hpp"
+#include "Utilities/SpinLock.hpp"
+#include "Utilities/SyncPolicy.hpp"
+
+namespace
+{
+    constexpr int64_t messages_per_iteration = 1 << 14;
+
+    // outside work between two acquisitions, the knob between light and heavy contention
+    void local_work(const int64_t rounds)
+    {
+        for (int64_t i = 0; i < rounds; ++i)
+            benchmark::DoNotOptimize(i);
+    }
+
+    template<typename Lock>
+    void lock_unlock(benchmark::State& state)
+    {
+        static Lock lock;
+        static int64_t shared = 0;
+        const auto rounds = state.range(0);
+
+        for (auto _ : state)
+        {
+            {
+                std::lock_guard<Lock> guard(lock);
+                ++shared;
+            }
+            local_work(rounds);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template<typename Policy>
+    using PolicyQueue = DataStructures::SynchronizedQueue<int64_t, std::allocator<int64_t>, Policy>;
+
+    // one producer streams into a consumer that sleeps whenever it catches up
+    template<typename Policy>
+    void producer_consumer(benchmark::State& state)
+    {
+        for (auto _ : state)
+        {
+            PolicyQueue<Policy> queue;
+            std::jthread producer(
+                [&queue]()
+                {
+                    for (int64_t i = 0; i < messages_per_iteration; ++i)
+                        queue.push(i);
+                });
+
+            int64_t sum = 0;
+            for (int64_t i = 0; i < messages_per_iteration; ++i)
+                sum += queue.wait_and_pop();
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * messages_per_iteration);
+    }
+}  // namespace
+
+// Arg = local work per acquisition: 1 thread is uncontended, 2 threads with work is
+// lightly contended, 8 threads without work is heavily contended
+static void BM_LockStdMutex(benchmark::State& state)
+{
+    lock_unlock<std::mutex>(state);
+}
+BENCHMARK(BM_LockStdMutex)->Arg(0)->Threads(1)->UseRealTime();
+BENCHMARK(BM_LockStdMutex)->Arg(200)->Threads(2)->UseRealTime();
+BENCHMARK(BM_LockStdMutex)->Arg(0)->Threads(8)->UseRealTime();
+
+static void BM_LockAdaptiveMutex(benchmark::State& state)
+{
+    lock_unlock<Utilities::Mutex>(state);
+}
+BENCHMARK(BM_LockAdaptiveMutex)->Arg(0)->Threads(1)->UseRealTime();
+BENCHMARK(BM_LockAdaptiveMutex)->Arg(200)->Threads(2)->UseRealTime();
+BENCHMARK(BM_LockAdaptiveMutex)->Arg(0)->Threads(8)->UseRealTime();
+
+static void BM_LockSpinLock(benchmark::State& state)
+{
+    lock_unlock<Utilities::SpinLock>(state);
+}
+BENCHMARK(BM_LockSpinLock)->Arg(0)->Threads(1)->UseRealTime();
+BENCHMARK(BM_LockSpinLock)->Arg(200)->Threads(2)->UseRealTime();
+BENCHMARK(BM_LockSpinLock)->Arg(0)->Threads(8)->UseRealTime();
+
+static void BM_ProducerConsumerStdPolicy(benchmark::State& state)
+{
+    producer_consumer<Utilities::StdSyncPolicy>(state);
+}
+BENCHMARK(BM_ProducerConsumerStdPolicy)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_ProducerConsumerAdaptivePolicy(benchmark::State& state)
+{
+    producer_consumer<Utilities::AdaptiveSyncPolicy>(state);
+}
+BENCHMARK(BM_ProducerConsumerAdaptivePolicy)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "Utilities/TaskGraph.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+// source -> Arg independent nodes -> sink, the graph is built once and run repeatedly
+static void BM_TaskGraphWide(benchmark::State& state)
+{
+    Utilities::ThreadPool pool;
+    Utilities::TaskGraph graph;
+    std::atomic<int64_t> work{0};
+
+    const auto source = graph.emplace([]() noexcept {});
+    const auto sink = graph.emplace([]() noexcept {});
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        const auto node = graph.emplace([&work]() noexcept { work.fetch_add(1, std::memory_order_relaxed); });
+        graph.precede(source, node);
+        graph.precede(node, sink);
+    }
+
+    for (auto _ : state)
+        graph.run(pool);
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(graph.size()));
+}
+BENCHMARK(BM_TaskGraphWide)->Arg(64)->Arg(1024)->Arg(16384)->UseRealTime();
+
+// a chain of Arg nodes, every node becomes ready inline on the worker that finished its predecessor
+static void BM_TaskGraphDeep(benchmark::State& state)
+{
+    Utilities::ThreadPool pool;
+    Utilities::TaskGraph graph;
+    std::atomic<int64_t> work{0};
+
+    auto previous = graph.emplace([]() noexcept {});
+    for (int64_t i = 1; i < state.range(0); ++i)
+    {
+        const auto node = graph.emplace([&work]() noexcept { work.fetch_add(1, std::memory_order_relaxed); });
+        graph.precede(previous, node);
+        previous = node;
+    }
+
+    for (auto _ : state)
+        graph.run(pool);
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(graph.size()));
+}
+BENCHMARK(BM_TaskGraphDeep)->Arg(64)->Arg(1024)->Arg(16384)->UseRealTime();
+
+// baseline for the wide graph: one future per task, joined by the caller
+static void BM_SubmitWide(benchmark::State& state)
+{
+    Utilities::ThreadPool pool;
+    std::atomic<int64_t> work{0};
+
+    for (auto _ : state)
+    {
+        std::vector<Utilities::AsyncResult<void>> results;
+        results.reserve(static_cast<size_t>(state.range(0)));
+        for (int64_t i = 0; i < state.range(0); ++i)
+            results.push_back(pool.submit([&work]() noexcept { work.fetch_add(1, std::memory_order_relaxed); }));
+
+        for (auto& result : results)
+            result.get();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SubmitWide)->Arg(64)->Arg(1024)->Arg(16384)->UseRealTime();
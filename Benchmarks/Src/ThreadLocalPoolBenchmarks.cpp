@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+
+#include "DataStructures/ConcurrentBlockQueue.hpp"
+#include "DataStructures/ConcurrentHashMap.hpp"
+#include "Utilities/ThreadLocalPool.hpp"
+
+namespace
+{
+    constexpr int64_t churn_per_iteration = 1024;
+    constexpr int64_t live_nodes = 256;
+    constexpr int64_t queue_items = 1 << 16;
+    constexpr int batch_entries = 10000;
+
+    // every thread keeps a working set of list nodes and keeps replacing them
+    template<typename Allocator>
+    void node_churn(benchmark::State& state)
+    {
+        std::list<int64_t, Allocator> nodes;
+        for (int64_t i = 0; i < live_nodes; ++i)
+            nodes.push_back(i);
+
+        for (auto _ : state)
+        {
+            for (int64_t i = 0; i < churn_per_iteration; ++i)
+            {
+                nodes.pop_front();
+                nodes.push_back(i);
+            }
+            benchmark::DoNotOptimize(nodes.back());
+        }
+
+        state.SetItemsProcessed(state.iterations() * churn_per_iteration);
+    }
+
+    // a producer allocates one block per item, the consumer frees it on another thread
+    template<typename Allocator>
+    void cross_thread_queue(benchmark::State& state)
+    {
+        for (auto _ : state)
+        {
+            DataStructures::ConcurrentBlockQueue<int64_t, 1, Allocator> queue;
+
+            std::jthread producer(
+                [&queue]()
+                {
+                    for (int64_t i = 0; i < queue_items; ++i)
+                        queue.push(int64_t{i});
+                });
+
+            int64_t sum = 0;
+            for (int64_t i = 0; i < queue_items; ++i)
+                sum += *queue.wait_and_pop();
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * queue_items);
+    }
+
+    template<typename Map>
+    void fill(Map& map)
+    {
+        for (int i = 0; i < batch_entries; ++i)
+            map.insert(int{i}, int{i});
+        benchmark::DoNotOptimize(map.was_size());
+    }
+}  // namespace
+
+static void BM_NodeChurnMalloc(benchmark::State& state)
+{
+    node_churn<std::allocator<int64_t>>(state);
+}
+BENCHMARK(BM_NodeChurnMalloc)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+
+static void BM_NodeChurnPool(benchmark::State& state)
+{
+    node_churn<Utilities::PoolAllocator<int64_t>>(state);
+}
+BENCHMARK(BM_NodeChurnPool)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+
+static void BM_CrossThreadFreeMalloc(benchmark::State& state)
+{
+    cross_thread_queue<std::allocator<int64_t>>(state);
+}
+BENCHMARK(BM_CrossThreadFreeMalloc)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_CrossThreadFreePool(benchmark::State& state)
+{
+    cross_thread_queue<Utilities::PoolAllocator<int64_t>>(state);
+}
+BENCHMARK(BM_CrossThreadFreePool)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// build a map for one batch job, then throw all of it away
+static void BM_BatchMapMalloc(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        DataStructures::ConcurrentHashMap<int, int> map;
+        fill(map);
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_entries);
+}
+BENCHMARK(BM_BatchMapMalloc)->Unit(benchmark::kMillisecond);
+
+static void BM_BatchMapPool(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        DataStructures::pmr::ConcurrentHashMap<int, int> map(Utilities::ThreadLocalPool::resource());
+        fill(map);
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_entries);
+}
+BENCHMARK(BM_BatchMapPool)->Unit(benchmark::kMillisecond);
+
+static void BM_BatchMapMonotonicArena(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::pmr::monotonic_buffer_resource arena(size_t{1} << 20);
+        DataStructures::pmr::ConcurrentHashMap<int, int> map(&arena);
+        fill(map);
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_entries);
+}
+BENCHMARK(BM_BatchMapMonotonicArena)->Unit(benchmark::kMillisecond);
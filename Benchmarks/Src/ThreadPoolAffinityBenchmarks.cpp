@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "Utilities/AsyncResult.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+namespace
+{
+    // sized to sit in a per-core L2, a migrated worker has to pull it in again
+    constexpr size_t working_set_bytes = 512 * 1024;
+    constexpr size_t tasks_per_iteration = 256;
+
+    uint64_t walk_working_set()
+    {
+        thread_local std::vector<uint64_t> working_set(working_set_bytes / sizeof(uint64_t), 1);
+
+        uint64_t sum = 0;
+        for (int pass = 0; pass < 4; ++pass)
+            sum += std::accumulate(working_set.begin(), working_set.end(), uint64_t{0});
+
+        return sum;
+    }
+}  // namespace
+
+/*
+ *  tasks that repeatedly walk a per-worker working set. Arg(0) leaves placement to
+ *  the OS, Arg(1) pins one worker per cpu in topology order.
+ */
+static void BM_CacheHeavyTasks(benchmark::State& state)
+{
+    const auto cpus = std::max(1u, std::thread::hardware_concurrency());
+    Utilities::ThreadPool pool(Utilities::ThreadPoolOptions{.workers = cpus, .pin_to_topology = state.range(0) != 0});
+
+    std::vector<Utilities::AsyncResult<uint64_t>> results;
+    results.reserve(tasks_per_iteration);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < tasks_per_iteration; ++i)
+            results.push_back(pool.submit([]() noexcept { return walk_working_set(); }));
+
+        for (auto& result : results)
+            benchmark::DoNotOptimize(result.get());
+
+        results.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tasks_per_iteration));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(tasks_per_iteration * working_set_bytes * 4));
+}
+BENCHMARK(BM_CacheHeavyTasks)->ArgName("pinned")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
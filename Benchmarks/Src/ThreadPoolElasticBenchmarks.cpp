@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "Utilities/AsyncResult.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+namespace
+{
+    constexpr int tasks_per_burst = 64;
+    constexpr auto blocking_work = std::chrono::microseconds(500);  // e.g. a storage round trip
+    constexpr auto quiet_gap = std::chrono::milliseconds(30);
+
+    constexpr size_t small_pool = 2;
+    constexpr size_t large_pool = 16;
+}  // namespace
+
+/*
+ *  bursts of blocking tasks separated by quiet gaps. Arg(0) is a fixed pool of 2,
+ *  Arg(1) a fixed pool of 16 and Arg(2) an elastic pool between 2 and 16 workers.
+ *  avg_workers samples the pool size every millisecond over the whole run.
+ */
+static void BM_BurstyLoad(benchmark::State& state)
+{
+    Utilities::ThreadPoolOptions options;
+    options.workers = state.range(0) == 1 ? large_pool : small_pool;
+    if (state.range(0) == 2)
+    {
+        options.max_workers = large_pool;
+        options.scale_up_wait = std::chrono::microseconds(200);
+        options.idle_timeout = std::chrono::milliseconds(10);
+        options.resize_cooldown = std::chrono::microseconds(200);
+    }
+
+    Utilities::ThreadPool pool(options);
+
+    std::atomic<size_t> samples{0};
+    std::atomic<size_t> sampled_workers{0};
+    std::jthread sampler(
+        [&](const std::stop_token& stop) noexcept
+        {
+            while (!stop.stop_requested())
+            {
+                sampled_workers.fetch_add(pool.size(), std::memory_order_relaxed);
+                samples.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+    std::vector<Utilities::AsyncResult<void>> burst;
+    burst.reserve(tasks_per_burst);
+    double burst_seconds = 0.0;
+
+    for (auto _ : state)
+    {
+        const auto started = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < tasks_per_burst; ++i)
+            burst.push_back(pool.submit([]() noexcept { std::this_thread::sleep_for(blocking_work); }));
+        for (auto& result : burst)
+            result.get();
+        burst.clear();
+
+        burst_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        state.PauseTiming();
+        std::this_thread::sleep_for(quiet_gap);
+        state.ResumeTiming();
+    }
+
+    sampler.request_stop();
+    sampler.join();
+
+    state.counters["burst_ms"] = 1000.0 * burst_seconds / static_cast<double>(state.iterations());
+    state.counters["avg_workers"] =
+        static_cast<double>(sampled_workers.load()) / static_cast<double>(std::max<size_t>(1, samples.load()));
+}
+BENCHMARK(BM_BurstyLoad)
+    ->ArgName("fixed2_fixed16_elastic")
+    ->DenseRange(0, 2)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(20);
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "Utilities/ThreadPool.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t pool_workers = 4;
+    constexpr int background_backlog = 256;
+    constexpr auto background_work = std::chrono::microseconds(20);
+
+    void spin_for(const std::chrono::microseconds duration)
+    {
+        const auto until = Clock::now() + duration;
+        while (Clock::now() < until)
+        {
+        }
+    }
+
+    double percentile(std::vector<double>& samples, const double rank)
+    {
+        if (samples.empty())
+            return 0.0;
+
+        const auto index = static_cast<size_t>(rank * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+        return samples[index];
+    }
+}  // namespace
+
+/*
+ *  submit-to-start latency of a probe task while a flooder keeps the pool saturated
+ *  with background work. Arg(0) submits everything as Normal, which is the old single
+ *  FIFO behaviour. Arg(1) floods with Background and probes with High.
+ */
+static void BM_ProbeLatencyUnderBackgroundLoad(benchmark::State& state)
+{
+    const bool prioritized = state.range(0) != 0;
+    const auto flood_priority = prioritized ? Utilities::TaskPriority::Background : Utilities::TaskPriority::Normal;
+    const auto probe_priority = prioritized ? Utilities::TaskPriority::High : Utilities::TaskPriority::Normal;
+
+    // declared before the pool, running tasks still touch it while the pool shuts down
+    std::atomic<int> backlog{0};
+    Utilities::ThreadPool pool(pool_workers);
+
+    std::jthread flooder(
+        [&](const std::stop_token& stop) noexcept
+        {
+            while (!stop.stop_requested())
+            {
+                if (backlog.load(std::memory_order_relaxed) >= background_backlog)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                backlog.fetch_add(1, std::memory_order_relaxed);
+                pool.submit({.priority = flood_priority},
+                            [&backlog]() noexcept
+                            {
+                                spin_for(background_work);
+                                backlog.fetch_sub(1, std::memory_order_relaxed);
+                            });
+            }
+        });
+
+    while (backlog.load(std::memory_order_relaxed) < background_backlog)
+        std::this_thread::yield();
+
+    std::vector<double> latencies;
+    for (auto _ : state)
+    {
+        const auto submitted = Clock::now();
+        auto started = pool.submit({.priority = probe_priority}, []() noexcept { return Clock::now(); });
+        latencies.push_back(std::chrono::duration<double, std::micro>(started.get() - submitted).count());
+    }
+
+    flooder.request_stop();
+    flooder.join();
+
+    state.counters["p50_us"] = percentile(latencies, 0.50);
+    state.counters["p99_us"] = percentile(latencies, 0.99);
+}
+BENCHMARK(BM_ProbeLatencyUnderBackgroundLoad)->ArgName("prioritized")->Arg(0)->Arg(1)->UseRealTime();
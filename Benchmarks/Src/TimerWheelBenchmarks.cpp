@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Utilities/FunctionWrapper.hpp"
+#include "Utilities/TimerWheel.hpp"
+
+namespace
+{
+    constexpr size_t outstanding_timers = 1'000'000;
+
+    void discard(Utilities::FunctionWrapper&&)
+    {
+    }
+
+    // timeouts spread between one second and one hour, so they land on every wheel level
+    std::vector<std::chrono::milliseconds> make_delays(const size_t count)
+    {
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<int64_t> spread(1'000, 3'600'000);
+
+        std::vector<std::chrono::milliseconds> delays;
+        delays.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            delays.emplace_back(spread(rng));
+
+        return delays;
+    }
+}  // namespace
+
+/*
+ *  insert + cancel of one timer while a million others are outstanding,
+ *  the typical life of a request timeout that doesn't fire.
+ */
+static void BM_TimerInsertCancelWithMillionOutstanding(benchmark::State& state)
+{
+    Utilities::TimerWheel wheel(discard);
+    const auto delays = make_delays(outstanding_timers);
+
+    std::vector<Utilities::TimerHandle> outstanding;
+    outstanding.reserve(outstanding_timers);
+    for (const auto delay : delays)
+        outstanding.push_back(wheel.schedule_after(delay, []() noexcept {}));
+
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        auto handle = wheel.schedule_after(delays[next], []() noexcept {});
+        benchmark::DoNotOptimize(handle.cancel());
+        next = (next + 1) % delays.size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerInsertCancelWithMillionOutstanding)->UseRealTime();
+
+// bulk insert then bulk cancel of a million timers
+static void BM_TimerMillionInsertThenCancel(benchmark::State& state)
+{
+    Utilities::TimerWheel wheel(discard);
+    const auto delays = make_delays(outstanding_timers);
+
+    std::vector<Utilities::TimerHandle> handles;
+    handles.reserve(outstanding_timers);
+
+    for (auto _ : state)
+    {
+        for (const auto delay : delays)
+            handles.push_back(wheel.schedule_after(delay, []() noexcept {}));
+
+        for (auto& handle : handles)
+            benchmark::DoNotOptimize(handle.cancel());
+
+        handles.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(outstanding_timers));
+}
+BENCHMARK(BM_TimerMillionInsertThenCancel)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,354 @@
+#ifndef _LIBRARY_DATASTRUCTURES_CHANNEL_HPP
+#define _LIBRARY_DATASTRUCTURES_CHANNEL_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace DataStructures
+{
+    namespace detail
+    {
+        // parked select( ) call, every channel it watches pokes it on send and close
+        struct SelectWaiter
+        {
+            std::mutex lock;
+            std::condition_variable signal;
+            bool signalled = false;
+
+            void notify()
+            {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    signalled = true;
+                }
+                signal.notify_one();
+            }
+        };
+    }  // namespace detail
+
+    /*
+     *  go-style channel.
+     *
+     *  - Capacity = 0 is unbounded, otherwise send( ) blocks while Capacity items are
+     *    queued, which pushes back on fast producers.
+     *  - close( ) rejects further sends, receivers still drain what was queued and then
+     *    get an empty optional.
+     *  - sends take an rvalue and only consume it on success.
+     */
+    template<typename T, size_t Capacity = 0>
+        requires(std::movable<T>)
+    class Channel
+    {
+        template<typename ValueT, size_t Bound, typename Fn>
+        friend class RecvCase;
+
+        std::deque<T> m_items;
+        bool m_closed = false;
+
+        mutable std::mutex m_lock;
+        std::condition_variable m_not_empty;
+        std::condition_variable m_not_full;
+        std::vector<detail::SelectWaiter*> m_selectors;
+
+        bool full() const
+        {
+            if constexpr (Capacity > 0)
+                return m_items.size() >= Capacity;
+
+            return false;
+        }
+
+        // caller holds m_lock
+        void push_and_notify(T&& value)
+        {
+            m_items.emplace_back(std::move(value));
+            m_not_empty.notify_one();
+
+            for (auto* selector : m_selectors)
+                selector->notify();
+        }
+
+        // caller holds m_lock
+        T pop_and_notify()
+        {
+            auto value = std::move(m_items.front());
+            m_items.pop_front();
+
+            if constexpr (Capacity > 0)
+                m_not_full.notify_one();
+
+            return value;
+        }
+
+        void attach(detail::SelectWaiter* selector)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_selectors.push_back(selector);
+        }
+
+        void detach(detail::SelectWaiter* selector)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_selectors.erase(std::remove(m_selectors.begin(), m_selectors.end(), selector), m_selectors.end());
+        }
+
+    public:
+        Channel() = default;
+        ~Channel() = default;
+
+        Channel(const Channel&) = delete;
+        Channel& operator=(const Channel&) = delete;
+        Channel(Channel&&) = delete;
+        Channel& operator=(Channel&&) = delete;
+
+        /*
+         *  retval: true = queued, false = channel closed (value untouched)
+         */
+        bool send(T&& value)
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_not_full.wait(guard, [this]() { return m_closed || !full(); });
+
+            if (m_closed)
+                return false;
+
+            push_and_notify(std::move(value));
+            return true;
+        }
+
+        // false when full or closed, the value is untouched then
+        bool try_send(T&& value)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (m_closed || full())
+                return false;
+
+            push_and_notify(std::move(value));
+            return true;
+        }
+
+        template<typename Rep, typename Period>
+        bool send_for(T&& value, const std::chrono::duration<Rep, Period>& timeout)
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            if (!m_not_full.wait_for(guard, timeout, [this]() { return m_closed || !full(); }) || m_closed)
+                return false;
+
+            push_and_notify(std::move(value));
+            return true;
+        }
+
+        // empty optional once the channel is closed and drained
+        std::optional<T> recv()
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_not_empty.wait(guard, [this]() { return m_closed || !m_items.empty(); });
+
+            if (m_items.empty())
+                return {};
+
+            return pop_and_notify();
+        }
+
+        std::optional<T> try_recv()
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (m_items.empty())
+                return {};
+
+            return pop_and_notify();
+        }
+
+        template<typename Rep, typename Period>
+        std::optional<T> recv_for(const std::chrono::duration<Rep, Period>& timeout)
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            if (!m_not_empty.wait_for(guard, timeout, [this]() { return m_closed || !m_items.empty(); }) ||
+                m_items.empty())
+                return {};
+
+            return pop_and_notify();
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_closed = true;
+
+            m_not_empty.notify_all();
+            m_not_full.notify_all();
+            for (auto* selector : m_selectors)
+                selector->notify();
+        }
+
+        bool closed() const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return m_closed;
+        }
+
+        size_t was_size() const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return m_items.size();
+        }
+
+        bool was_empty() const
+        {
+            return was_size() == 0;
+        }
+    };
+
+    /*
+     *  one receive arm of a select( ). the handler gets the received value, or an empty
+     *  optional when the channel is closed and drained (a closed channel is always ready).
+     */
+    template<typename T, size_t Capacity, typename Fn>
+    class RecvCase
+    {
+        Channel<T, Capacity>* m_channel;
+        Fn m_handler;
+
+    public:
+        RecvCase(Channel<T, Capacity>& channel, Fn handler)
+            : m_channel(&channel)
+            , m_handler(std::move(handler))
+        {
+        }
+
+        bool try_fire()
+        {
+            std::optional<T> value;
+            {
+                std::lock_guard<std::mutex> guard(m_channel->m_lock);
+                if (m_channel->m_items.empty() && !m_channel->m_closed)
+                    return false;
+
+                if (!m_channel->m_items.empty())
+                    value = m_channel->pop_and_notify();
+            }
+
+            // the handler runs unlocked, it may use the channel itself
+            m_handler(std::move(value));
+            return true;
+        }
+
+        void attach(detail::SelectWaiter* selector)
+        {
+            m_channel->attach(selector);
+        }
+
+        void detach(detail::SelectWaiter* selector)
+        {
+            m_channel->detach(selector);
+        }
+    };
+
+    template<typename T, size_t Capacity, typename Fn>
+    RecvCase<T, Capacity, Fn> on_recv(Channel<T, Capacity>& channel, Fn handler)
+    {
+        return {channel, std::move(handler)};
+    }
+
+    namespace detail
+    {
+        template<typename Cases, size_t... Is>
+        bool try_fire_at(Cases& cases, const size_t index, std::index_sequence<Is...>)
+        {
+            bool fired = false;
+            static_cast<void>(((index == Is && (fired = std::get<Is>(cases).try_fire(), true)) || ...));
+            return fired;
+        }
+
+        // tries every case once, starting at a rotating offset so no arm starves the others
+        template<typename Cases>
+        std::optional<size_t> try_fire_any(Cases& cases, const size_t start)
+        {
+            constexpr auto count = std::tuple_size_v<Cases>;
+
+            for (size_t offset = 0; offset < count; ++offset)
+            {
+                const auto index = (start + offset) % count;
+                if (try_fire_at(cases, index, std::make_index_sequence<count>{}))
+                    return index;
+            }
+
+            return {};
+        }
+
+        template<typename Cases, typename WaitFn>
+        std::optional<size_t> select_impl(Cases& cases, WaitFn&& wait)
+        {
+            thread_local size_t rotation = 0;
+            const auto start = rotation++;
+
+            if (auto fired = try_fire_any(cases, start))
+                return fired;
+
+            SelectWaiter waiter;
+            std::apply([&waiter](auto&... arm) { (arm.attach(&waiter), ...); }, cases);
+
+            std::optional<size_t> fired;
+            while (true)
+            {
+                // re-check after attaching, a send in between has signalled the waiter anyway
+                fired = try_fire_any(cases, start);
+                if (fired)
+                    break;
+
+                std::unique_lock<std::mutex> guard(waiter.lock);
+                if (!wait(waiter, guard))
+                    break;
+                waiter.signalled = false;
+            }
+
+            std::apply([&waiter](auto&... arm) { (arm.detach(&waiter), ...); }, cases);
+            return fired;
+        }
+    }  // namespace detail
+
+    /*
+     *  blocks until one of the cases can receive, runs its handler and returns its
+     *  position in the argument list. usage:
+     *      select( on_recv( requests, handle_request ), on_recv( shutdown, handle_shutdown ) );
+     */
+    template<typename... Cases>
+        requires(sizeof...(Cases) > 0)
+    size_t select(Cases&&... cases)
+    {
+        std::tuple<Cases&...> arms(cases...);
+        return *detail::select_impl(arms,
+                                    [](detail::SelectWaiter& waiter, std::unique_lock<std::mutex>& guard)
+                                    {
+                                        waiter.signal.wait(guard, [&waiter]() { return waiter.signalled; });
+                                        return true;
+                                    });
+    }
+
+    // as select( ), empty optional if no case became ready within the timeout
+    template<typename Rep, typename Period, typename... Cases>
+        requires(sizeof...(Cases) > 0)
+    std::optional<size_t> select_for(const std::chrono::duration<Rep, Period>& timeout, Cases&&... cases)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::tuple<Cases&...> arms(cases...);
+
+        return detail::select_impl(arms,
+                                   [deadline](detail::SelectWaiter& waiter, std::unique_lock<std::mutex>& guard)
+                                   {
+                                       return waiter.signal.wait_until(
+                                           guard, deadline, [&waiter]() { return waiter.signalled; });
+                                   });
+    }
+}  // namespace DataStructures
+
+#endif  // !_LIBRARY_DATASTRUCTURES_CHANNEL_HPP
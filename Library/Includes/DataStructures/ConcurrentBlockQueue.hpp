@@ -1,31 +1,80 @@
 #ifndef _LIBRARY_DATASTRUCTURES_CONCURRENTBLOCKQUEUE_HPP
 #define _LIBRARY_DATASTRUCTURES_CONCURRENTBLOCKQUEUE_HPP
 
+#include <algorithm>
 #include <atomic>
 #include <concepts>
-#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
 #include <utility>
 #include <vector>
 
+#include "Utilities/CacheLine.hpp"
+#include "Utilities/ShardedCounter.hpp"
+#include "Utilities/SyncPolicy.hpp"
+
 namespace DataStructures
 {
-    template<typename T, size_t BLOCK_SIZE = 512>
+    /*
+     *  Allocator serves both the blocks and the values stored in them.
+     *  blocks are allocated under the push lock and freed under the pop lock.
+     *
+     *  SizeCounter only backs was_size( ) / was_empty( ), pops find data through the
+     *  per-block published count. Utilities::ShardedCounter keeps push and pop off a
+     *  shared cache line, at the price of an approximate was_size( ).
+     *
+     *  SyncPolicy picks the head / tail locks and the consumer wake-up. push( ) only
+     *  wakes a consumer that is actually parked in wait_and_pop( ).
+     *
+     *  consumer state (Head), producer state (Tail), the size counter and the wake-up
+     *  state each start a cache line, so push and pop don't invalidate each other's lines.
+     */
+    template<typename T,
+             size_t BLOCK_SIZE = 512,
+             typename Allocator = std::allocator<T>,
+             Utilities::CounterPolicy SizeCounter = Utilities::AtomicCounter,
+             Utilities::SyncPolicy SyncPolicy = Utilities::StdSyncPolicy>
         requires(std::copyable<T> || std::movable<T>)
     class ConcurrentBlockQueue
     {
+        using mutex_type = typename SyncPolicy::mutex_type;
+
         /////////////////////////////////////////////
         ///  PRIVATE DATA STRUCTURES
         /////////////////////////////////////////////
+        struct Node;
+
+        using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+        using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+        // points back at the queue's allocator, polymorphic allocators can't be reassigned
+        struct NodeDeleter
+        {
+            NodeAllocator* allocator = nullptr;
+
+            void operator()(Node* node) const
+            {
+                NodeTraits::destroy(*allocator, node);
+                NodeTraits::deallocate(*allocator, node, 1);
+            }
+        };
+
+        using NodePtr = std::unique_ptr<Node, NodeDeleter>;
+
         struct Node
         {
-            std::vector<T> data = {};
-            std::unique_ptr<Node> next = nullptr;
+            std::vector<T, Allocator> data;
+            NodePtr next = nullptr;
+
+            // elements the consumer may take, stored after the element (and the next block) is in place
+            std::atomic<size_t> published{0};
 
-            Node()
+            explicit Node(const Allocator& allocator)
+                : data(allocator)
             {
                 data.reserve(BLOCK_SIZE);
             }
@@ -38,11 +87,16 @@ namespace DataStructures
             Node& operator=(const Node&) = delete;
         };
 
-        struct Head
+        struct alignas(Utilities::cache_line_size) Head
         {
-            std::unique_ptr<Node> head_block = nullptr;
+            NodePtr head_block = nullptr;
             size_t block_offset = 0;
-            std::mutex lock;
+            mutex_type lock;
+
+            bool has_data() const
+            {
+                return head_block->published.load(std::memory_order_acquire) > block_offset;
+            }
 
             T pop_data()
             {
@@ -78,18 +132,19 @@ namespace DataStructures
             Head(Head&&) = default;
             Head& operator=(Head&&) = default;
 
-            explicit Head(std::unique_ptr<Node> _head)
+            explicit Head(NodePtr _head)
                 : head_block(std::move(_head))
                 , block_offset(0)
             {
             }
         };
 
-        struct Tail
+        struct alignas(Utilities::cache_line_size) Tail
         {
             Node* tail_block = nullptr;
             size_t block_offset = 0;
-            std::mutex lock;
+            mutex_type lock;
+            NodeAllocator* allocator = nullptr;
 
             Tail() = default;
             ~Tail() = default;
@@ -98,33 +153,56 @@ namespace DataStructures
             Tail(Tail&&) = default;
             Tail& operator=(Tail&&) = default;
 
-            void update_tail()
+            inline void add_data(T&& val)
             {
-                ++block_offset;
+                // the next block is allocated up front, a throwing allocation leaves the queue as it was
+                auto next = block_offset + 1 == BLOCK_SIZE ? make_node(*allocator) : NodePtr();
+
+                auto* filled = tail_block;
+                filled->data.emplace_back(std::move(val));
+                const auto published = ++block_offset;
+
                 if (block_offset == BLOCK_SIZE)
                 {
-                    auto next = std::make_unique<Node>();
                     tail_block->next = std::move(next);
                     tail_block = (tail_block->next).get();
                     block_offset = 0;
                 }
+
+                // last touch of `filled`, the consumer may free it right after
+                filled->published.store(published, std::memory_order_release);
             }
+        };
 
-            inline void add_data(T&& val)
+        static NodePtr make_node(NodeAllocator& allocator)
+        {
+            auto* node = NodeTraits::allocate(allocator, 1);
+            try
             {
-                tail_block->data.emplace_back(std::move(val));
-                update_tail();
+                NodeTraits::construct(allocator, node, Allocator(allocator));
+            }
+            catch (...)
+            {
+                NodeTraits::deallocate(allocator, node, 1);
+                throw;
             }
-        };
+
+            return NodePtr(node, NodeDeleter{&allocator});
+        }
 
         /////////////////////////////////////////////
         ///  PRIVATE DATA MEMBERS
         /////////////////////////////////////////////
+        NodeAllocator m_allocator;  // declared first, blocks are freed through it
         Head m_head;
         Tail m_tail;
 
-        std::atomic<size_t> m_size{0};
-        std::condition_variable m_queue_signal;
+        // written by both ends
+        alignas(Utilities::cache_line_size) SizeCounter m_size;
+
+        // read by every push, written only when consumers wait or the mode changes
+        alignas(Utilities::cache_line_size) typename SyncPolicy::condition_type m_queue_signal;
+        std::atomic<size_t> m_waiters{0};  // consumers in wait_and_pop( ), unused with lock_free_notify
 
         /*
          * - controlled by client
@@ -133,16 +211,46 @@ namespace DataStructures
          */
         std::atomic<bool> m_clear_mode_enabled{false};
 
+        /*
+         *  push( ) publishes under the tail lock while consumers wait under the head lock.
+         *  a condition without lock_free_notify could lose the wake-up of a consumer that
+         *  checked for data but isn't asleep yet, that consumer still holds the head lock.
+         */
+        void wake_consumers(const bool all)
+        {
+            if constexpr (!SyncPolicy::lock_free_notify)
+            {
+                // pairs with the fence in wait_and_pop( ): we see the waiter, or it sees the data
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (m_waiters.load(std::memory_order_relaxed) == 0)
+                    return;
+
+                std::lock_guard<mutex_type> handoff(m_head.lock);
+            }
+
+            if (all)
+                m_queue_signal.notify_all();
+            else
+                m_queue_signal.notify_one();
+        }
+
         /////////////////////////////////////////////
         ///  PUBLIC API
         /////////////////////////////////////////////
 
     public:
         ConcurrentBlockQueue()
-            : m_head(std::move(std::make_unique<Node>()))
+            : ConcurrentBlockQueue(Allocator())
+        {
+        }
+
+        explicit ConcurrentBlockQueue(const Allocator& allocator)
+            : m_allocator(allocator)
+            , m_head(make_node(m_allocator))
         {
             m_tail.tail_block = m_head.head_block.get();
             m_tail.block_offset = m_head.block_offset;
+            m_tail.allocator = &m_allocator;
         }
 
         ConcurrentBlockQueue(const ConcurrentBlockQueue&) = delete;
@@ -157,23 +265,26 @@ namespace DataStructures
          */
         size_t push(T&& val)
         {
-            std::lock_guard<std::mutex> guard(m_tail.lock);
-            if (m_clear_mode_enabled)
-                return 1;
-            m_tail.add_data(std::move(val));
-            ++m_size;
-            m_queue_signal.notify_one();
+            {
+                std::lock_guard<mutex_type> guard(m_tail.lock);
+                if (m_clear_mode_enabled)
+                    return 1;
+                m_tail.add_data(std::move(val));
+                m_size.increment();
+            }
+
+            wake_consumers(false);
 
             return 0;  // success
         }
 
         std::optional<T> try_pop()
         {
-            std::lock_guard<std::mutex> guard(m_head.lock);
-            if (not was_empty())
+            std::lock_guard<mutex_type> guard(m_head.lock);
+            if (m_head.has_data())
             {
                 auto data = m_head.pop_data();
-                --m_size;
+                m_size.decrement();
                 return {std::move(data)};
             }
 
@@ -182,14 +293,26 @@ namespace DataStructures
 
         std::optional<T> wait_and_pop()
         {
-            std::unique_lock<std::mutex> guard(m_head.lock);
-            m_queue_signal.wait(guard, [this]() { return m_clear_mode_enabled || not was_empty(); });
+            std::unique_lock<mutex_type> guard(m_head.lock);
+            const auto ready = [this]() { return m_clear_mode_enabled || m_head.has_data(); };
+
+            if constexpr (SyncPolicy::lock_free_notify)
+            {
+                m_queue_signal.wait(guard, ready);
+            }
+            else if (!ready())
+            {
+                m_waiters.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                m_queue_signal.wait(guard, ready);
+                m_waiters.fetch_sub(1, std::memory_order_relaxed);
+            }
 
-            if (m_clear_mode_enabled && was_empty())
+            if (not m_head.has_data())
                 return {};
 
             auto data{m_head.pop_data()};
-            --m_size;
+            m_size.decrement();
 
             return data;
         }
@@ -197,19 +320,27 @@ namespace DataStructures
         void enable_clear_mode()
         {
             m_clear_mode_enabled = true;
-            m_queue_signal.notify_all();
+            wake_consumers(true);
         }
 
         bool was_empty() const
         {
-            return !m_size;
+            return was_size() == 0;
         }
 
         size_t was_size() const
         {
-            return m_size;
+            // a sharded count may see a pop before its push
+            return static_cast<size_t>(std::max<int64_t>(m_size.load(), 0));
         }
     };
+
+    namespace pmr
+    {
+        template<typename T, size_t BLOCK_SIZE = 512>
+        using ConcurrentBlockQueue =
+            DataStructures::ConcurrentBlockQueue<T, BLOCK_SIZE, std::pmr::polymorphic_allocator<T>>;
+    }  // namespace pmr
 }  // namespace DataStructures
 
 #endif  // !_LIBRARY_DATASTRUCTURES_CONCURRENTBLOCKQUEUE_HPP
@@ -1,37 +1,82 @@
 #ifndef _LIBRARY_DATASTRUCTURES_CONCURRENTHASHMAP_HPP
 #define _LIBRARY_DATASTRUCTURES_CONCURRENTHASHMAP_HPP
 
+#include <algorithm>
 #include <array>
-#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <unordered_map>
 #include <utility>
 
+#include "Utilities/CacheLine.hpp"
+#include "Utilities/ShardedCounter.hpp"
+
 namespace DataStructures
 {
-    template<class KeyT, class ValueT, class HashFn = std::hash<KeyT>, const size_t BUCKETS = 1031>
+    /*
+     *  Allocator is shared by every bucket and used under that bucket's lock only.
+     *  SizeCounter backs was_size( ), Utilities::ShardedCounter keeps independent buckets
+     *  from contending on one counter at the price of an approximate size.
+     */
+    template<class KeyT,
+             class ValueT,
+             class HashFn = std::hash<KeyT>,
+             const size_t BUCKETS = 1031,
+             class Allocator = std::allocator<std::pair<const KeyT, ValueT>>,
+             Utilities::CounterPolicy SizeCounter = Utilities::AtomicCounter>
     class ConcurrentHashMap
     {
-        struct Bucket
+        // a bucket starts a cache line, threads working on neighbouring buckets don't share lines.
+        // the lock comes first, every access writes it before touching the map
+        struct alignas(Utilities::cache_line_size) Bucket
         {
-            std::unordered_map<KeyT, ValueT> bucket_;
             mutable std::shared_mutex rwlock_;
+            std::unordered_map<KeyT, ValueT, std::hash<KeyT>, std::equal_to<KeyT>, Allocator> bucket_;
+
+            explicit Bucket(const Allocator& allocator)
+                : bucket_(allocator)
+            {
+            }
         };
 
         std::array<Bucket, BUCKETS> m_buckets;
         HashFn m_hasher;
-        std::atomic<size_t> m_size{0};
+        alignas(Utilities::cache_line_size) SizeCounter m_size;  // written by every insert & remove
 
         inline size_t get_bucket(const KeyT& key) const
         {
             return m_hasher(key) % BUCKETS;
         }
 
+        static Bucket make_bucket(const Allocator& allocator, size_t /*index*/)
+        {
+            return Bucket(allocator);
+        }
+
+        // buckets hold a mutex, so they are built in place rather than assigned an allocator later
+        template<size_t... Index>
+        static std::array<Bucket, BUCKETS> make_buckets(const Allocator& allocator, std::index_sequence<Index...>)
+        {
+            return {{make_bucket(allocator, Index)...}};
+        }
+
     public:
+        ConcurrentHashMap()
+            : ConcurrentHashMap(Allocator())
+        {
+        }
+
+        explicit ConcurrentHashMap(const Allocator& allocator)
+            : m_buckets(make_buckets(allocator, std::make_index_sequence<BUCKETS>{}))
+        {
+        }
+
         void insert(KeyT&& key, ValueT&& value)
         {
             auto bucket_id = get_bucket(key);
@@ -40,8 +85,8 @@ namespace DataStructures
             auto& rwlock = m_buckets[bucket_id].rwlock_;
 
             std::lock_guard<std::shared_mutex> guard(rwlock);
-            bucket.emplace(std::forward<KeyT>(key), std::forward<ValueT>(value));
-            ++m_size;
+            if (bucket.emplace(std::forward<KeyT>(key), std::forward<ValueT>(value)).second)
+                m_size.increment();
         }
 
         std::optional<ValueT> remove(const KeyT& key)
@@ -56,7 +101,7 @@ namespace DataStructures
             {
                 auto retVal = std::move(pos->second);
                 bucket.erase(pos);
-                --m_size;
+                m_size.decrement();
 
                 return {retVal};
             }
@@ -81,13 +126,21 @@ namespace DataStructures
 
         size_t was_size() const
         {
-            return m_size;
+            // a sharded count may see a remove before its insert
+            return static_cast<size_t>(std::max<int64_t>(m_size.load(), 0));
         }
 
         bool was_empty() const
         {
-            return !m_size;
+            return was_size() == 0;
         }
     };
+
+    namespace pmr
+    {
+        template<class KeyT, class ValueT, class HashFn = std::hash<KeyT>, const size_t BUCKETS = 1031>
+        using ConcurrentHashMap = DataStructures::
+            ConcurrentHashMap<KeyT, ValueT, HashFn, BUCKETS, std::pmr::polymorphic_allocator<std::pair<const KeyT, ValueT>>>;
+    }  // namespace pmr
 }  // namespace DataStructures
 #endif  // !_LIBRARY_DATASTRUCTURES_CONCURRENTHASHMAP_HPP
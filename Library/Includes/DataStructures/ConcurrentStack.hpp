@@ -2,35 +2,53 @@
 #define _LIBRARY_DATASTRUCTURES_CONCURRENTSTACK_HPP
 
 #include <atomic>
-#include <condition_variable>
 #include <cstddef>
 #include <deque>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
 #include <type_traits>
 #include <vector>
 #include <utility>
 
+#include "Utilities/SyncPolicy.hpp"
+
 namespace DataStructures
 {
 
-    template<typename Data, size_t ContainerSize = 0>
+    template<typename Data,
+             size_t ContainerSize = 0,
+             typename Allocator = std::allocator<Data>,
+             Utilities::SyncPolicy SyncPolicy = Utilities::StdSyncPolicy>
     class ConcurrentStack
     {
-        using unbounded_container = std::deque<Data>;
-        using bounded_container = std::vector<Data>;
+        using mutex_type = typename SyncPolicy::mutex_type;
+
+        using unbounded_container = std::deque<Data, Allocator>;
+        using bounded_container = std::vector<Data, Allocator>;
 
         std::conditional_t<(ContainerSize > 0), bounded_container, unbounded_container> m_stack;
         std::atomic<size_t> m_size;
 
         // synchronization primitives
-        std::mutex m_lock;
-        std::condition_variable m_sync;
+        mutex_type m_lock;
+        typename SyncPolicy::condition_type m_sync;
 
     public:
+        ConcurrentStack()
+            : ConcurrentStack(Allocator())
+        {
+        }
+
+        explicit ConcurrentStack(const Allocator& allocator)
+            : m_stack(allocator)
+        {
+        }
+
         std::optional<Data> try_pop()
         {
-            std::lock_guard<std::mutex> guard(m_lock);
+            std::lock_guard<mutex_type> guard(m_lock);
             if (was_empty())
                 return {};
 
@@ -44,7 +62,7 @@ namespace DataStructures
 
         Data wait_and_pop()
         {
-            std::unique_lock<std::mutex> guard(m_lock);
+            std::unique_lock<mutex_type> guard(m_lock);
             m_sync.wait(guard, [this]() { return not was_empty(); });
 
             auto retval = std::move(m_stack.back());
@@ -57,7 +75,7 @@ namespace DataStructures
 
         bool push(Data value)
         {
-            std::lock_guard<std::mutex> guard(m_lock);
+            std::lock_guard<mutex_type> guard(m_lock);
 
             if constexpr (ContainerSize > 0)
             {
@@ -83,6 +101,13 @@ namespace DataStructures
         }
     };
 
+    namespace pmr
+    {
+        template<typename Data, size_t ContainerSize = 0>
+        using ConcurrentStack =
+            DataStructures::ConcurrentStack<Data, ContainerSize, std::pmr::polymorphic_allocator<Data>>;
+    }  // namespace pmr
+
 }  // namespace DataStructures
 
 #endif  // !_LIBRARY_DATASTRUCTURES_CONCURRENTSTACK_HPP
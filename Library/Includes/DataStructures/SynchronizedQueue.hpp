@@ -2,23 +2,30 @@
 #define _LIBRARY_DATASTRUCTURES_SYNCHRONIZEDQUEUE_HPP
 
 #include <concepts>
-#include <condition_variable>
 #include <cstddef>
 #include <deque>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
 #include <utility>
 
+#include "Utilities/SyncPolicy.hpp"
+
 namespace DataStructures
 {
 
-    template<typename Data>
+    template<typename Data,
+             typename Allocator = std::allocator<Data>,
+             Utilities::SyncPolicy SyncPolicy = Utilities::StdSyncPolicy>
         requires(std::copyable<Data> || std::movable<Data>)
     class SynchronizedQueue
     {
-        std::deque<Data> data;
-        mutable std::mutex lock;
-        std::condition_variable conditional;
+        using mutex_type = typename SyncPolicy::mutex_type;
+
+        std::deque<Data, Allocator> data;
+        mutable mutex_type lock;
+        typename SyncPolicy::condition_type conditional;
 
         auto pop_and_return()
         {
@@ -28,9 +35,19 @@ namespace DataStructures
         }
 
     public:
+        SynchronizedQueue()
+            : SynchronizedQueue(Allocator())
+        {
+        }
+
+        explicit SynchronizedQueue(const Allocator& allocator)
+            : data(allocator)
+        {
+        }
+
         std::optional<Data> try_pop()
         {
-            std::lock_guard<std::mutex> guard(lock);
+            std::lock_guard<mutex_type> guard(lock);
             if (data.empty())
                 return {};
 
@@ -39,7 +56,7 @@ namespace DataStructures
 
         Data wait_and_pop()
         {
-            std::unique_lock<std::mutex> guard(lock);
+            std::unique_lock<mutex_type> guard(lock);
             conditional.wait(guard, [this]() { return !data.empty(); });
 
             return pop_and_return();
@@ -47,24 +64,30 @@ namespace DataStructures
 
         void push(Data val)
         {
-            std::lock_guard<std::mutex> guard(lock);
+            std::lock_guard<mutex_type> guard(lock);
             data.emplace_back(std::move(val));
             conditional.notify_one();
         }
 
         size_t was_size() const
         {
-            std::lock_guard<std::mutex> guard(lock);
+            std::lock_guard<mutex_type> guard(lock);
             return data.size();
         }
 
         bool was_empty() const
         {
-            std::lock_guard<std::mutex> guard(lock);
+            std::lock_guard<mutex_type> guard(lock);
             return data.empty();
         }
     };
 
+    namespace pmr
+    {
+        template<typename Data>
+        using SynchronizedQueue = DataStructures::SynchronizedQueue<Data, std::pmr::polymorphic_allocator<Data>>;
+    }  // namespace pmr
+
 }  // namespace DataStructures
 
 #endif  // !_LIBRARY_DATASTRUCTURES_SYNCHRONIZEDQUEUE_HPP
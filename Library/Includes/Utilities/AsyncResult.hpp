@@ -10,7 +10,7 @@ namespace Utilities
 {
 
     template<typename ResultT>
-        requires(std::copyable<ResultT> || std::movable<ResultT>)
+        requires(std::is_void_v<ResultT> || std::copyable<ResultT> || std::movable<ResultT>)
     class AsyncResult
     {
         std::future<ResultT> m_waitable;
@@ -30,7 +30,7 @@ namespace Utilities
         AsyncResult(AsyncResult&&) = default;
         AsyncResult& operator=(AsyncResult&&) = default;
 
-        template<typename Fn, std::enable_if_t<!std::is_same_v<void, ResultT>, int> = 0>
+        template<typename Fn, typename R = ResultT, std::enable_if_t<!std::is_same_v<void, R>, int> = 0>
             requires std::movable<Fn>
         inline auto then(Fn&& callback)
         {
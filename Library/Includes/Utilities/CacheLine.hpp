@@ -0,0 +1,23 @@
+#ifndef _LIBRARY_UTILITIES_CACHELINE_HPP
+#define _LIBRARY_UTILITIES_CACHELINE_HPP
+
+#include <cstddef>
+
+namespace Utilities
+{
+    /*
+     *  destructive interference size used for padding. fixed rather than taken from
+     *  std::hardware_destructive_interference_size, which changes with -mtune and so
+     *  isn't safe to bake into a header-only library's layouts.
+     */
+    inline constexpr size_t cache_line_size = 64;
+
+    // a value alone on its own cache line(s)
+    template<typename T>
+    struct alignas(cache_line_size) CachePadded
+    {
+        T value{};
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_CACHELINE_HPP
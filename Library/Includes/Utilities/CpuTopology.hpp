@@ -0,0 +1,229 @@
+#ifndef _LIBRARY_UTILITIES_CPUTOPOLOGY_HPP
+#define _LIBRARY_UTILITIES_CPUTOPOLOGY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Utilities
+{
+    struct LogicalCpu
+    {
+        unsigned id = 0;
+        unsigned package = 0;
+        unsigned core = 0;       // core_id, unique within a package only
+        unsigned smt_index = 0;  // 0 for the first hardware thread of a core, 1 for its sibling, ...
+        size_t l3_domain = 0;    // cpus sharing one last level cache, dense from 0
+    };
+
+    /*
+     *  logical cpus this process may run on, read from /sys/devices/system/cpu.
+     *  falls back to hardware_concurrency( ) cpus in a single domain when sysfs
+     *  isn't available.
+     */
+    class CpuTopology
+    {
+        std::vector<LogicalCpu> m_cpus;
+        size_t m_l3_domains = 0;
+
+        static bool read_value(const std::string& path, std::string& value)
+        {
+            std::ifstream in(path);
+            return static_cast<bool>(std::getline(in, value));
+        }
+
+        static bool read_number(const std::string& path, unsigned& value)
+        {
+            std::ifstream in(path);
+            return static_cast<bool>(in >> value);
+        }
+
+        static CpuTopology fallback()
+        {
+            CpuTopology topology;
+
+            const auto count = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned cpu = 0; cpu < count; ++cpu)
+                topology.m_cpus.push_back({cpu, 0, cpu, 0, 0});
+
+            topology.m_l3_domains = 1;
+            return topology;
+        }
+
+    public:
+        // parses kernel cpu lists such as "0-3,8,10-11"
+        static std::vector<unsigned> parse_cpu_list(const std::string& text)
+        {
+            std::vector<unsigned> cpus;
+            std::stringstream ranges(text);
+
+            for (std::string range; std::getline(ranges, range, ',');)
+            {
+                if (range.empty())
+                    continue;
+
+                const auto dash = range.find('-');
+                try
+                {
+                    const auto first = static_cast<unsigned>(std::stoul(range.substr(0, dash)));
+                    const auto last =
+                        dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(range.substr(dash + 1)));
+
+                    for (auto cpu = first; cpu <= last; ++cpu)
+                        cpus.push_back(cpu);
+                }
+                catch (const std::exception&)
+                {
+                    return {};
+                }
+            }
+
+            return cpus;
+        }
+
+        // only_allowed = skip cpus outside the process affinity mask (cgroup cpusets, taskset)
+        static CpuTopology detect(const std::string& sysfs_root = "/sys/devices/system/cpu",
+                                  const bool only_allowed = true)
+        {
+            std::string online;
+            if (!read_value(sysfs_root + "/online", online))
+                return fallback();
+
+#if defined(__linux__)
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            const bool masked = only_allowed && sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+#else
+            static_cast<void>(only_allowed);
+#endif
+
+            CpuTopology topology;
+            std::map<std::string, size_t> l3_ids;
+            std::map<std::tuple<unsigned, unsigned>, unsigned> threads_per_core;
+
+            for (const auto cpu : parse_cpu_list(online))
+            {
+#if defined(__linux__)
+                if (masked && (cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed)))
+                    continue;
+#endif
+
+                const auto cpu_root = sysfs_root + "/cpu" + std::to_string(cpu);
+
+                LogicalCpu logical;
+                logical.id = cpu;
+                if (!read_number(cpu_root + "/topology/physical_package_id", logical.package))
+                    logical.package = 0;
+                if (!read_number(cpu_root + "/topology/core_id", logical.core))
+                    logical.core = cpu;
+
+                logical.smt_index = threads_per_core[{logical.package, logical.core}]++;
+
+                // cpus without a visible L3 get grouped by package
+                std::string shared = "package" + std::to_string(logical.package);
+                for (unsigned index = 0;; ++index)
+                {
+                    const auto cache_root = cpu_root + "/cache/index" + std::to_string(index);
+
+                    unsigned level = 0;
+                    if (!read_number(cache_root + "/level", level))
+                        break;
+
+                    std::string cpus;
+                    if (level == 3 && read_value(cache_root + "/shared_cpu_list", cpus))
+                        shared = cpus;
+                }
+
+                logical.l3_domain = l3_ids.try_emplace(shared, l3_ids.size()).first->second;
+                topology.m_cpus.push_back(logical);
+            }
+
+            if (topology.m_cpus.empty())
+                return fallback();
+
+            topology.m_l3_domains = l3_ids.size();
+            return topology;
+        }
+
+        const std::vector<LogicalCpu>& cpus() const
+        {
+            return m_cpus;
+        }
+
+        size_t l3_domains() const
+        {
+            return m_l3_domains;
+        }
+
+        // l3 domain of a cpu id, 0 for cpus outside the topology
+        size_t l3_domain_of(const unsigned cpu) const
+        {
+            for (const auto& logical : m_cpus)
+                if (logical.id == cpu)
+                    return logical.l3_domain;
+
+            return 0;
+        }
+
+        /*
+         *  cpu order for placing workers one per cpu: grouped by l3 domain, and within a
+         *  domain one hardware thread per physical core before any SMT sibling.
+         */
+        std::vector<unsigned> placement() const
+        {
+            auto ordered = m_cpus;
+            std::stable_sort(ordered.begin(),
+                             ordered.end(),
+                             [](const LogicalCpu& lhs, const LogicalCpu& rhs)
+                             {
+                                 return std::tie(lhs.l3_domain, lhs.smt_index, lhs.package, lhs.core) <
+                                        std::tie(rhs.l3_domain, rhs.smt_index, rhs.package, rhs.core);
+                             });
+
+            std::vector<unsigned> order;
+            order.reserve(ordered.size());
+            for (const auto& logical : ordered)
+                order.push_back(logical.id);
+
+            return order;
+        }
+    };
+
+    // restricts a thread to the given cpus, false if the platform or the kernel refused
+    inline bool pin_thread(std::thread::native_handle_type thread, const std::vector<unsigned>& cpus)
+    {
+#if defined(__linux__)
+        if (cpus.empty())
+            return false;
+
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        for (const auto cpu : cpus)
+        {
+            if (cpu >= CPU_SETSIZE)
+                return false;
+            CPU_SET(cpu, &mask);
+        }
+
+        return pthread_setaffinity_np(thread, sizeof(mask), &mask) == 0;
+#else
+        static_cast<void>(thread);
+        static_cast<void>(cpus);
+        return false;
+#endif
+    }
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_CPUTOPOLOGY_HPP
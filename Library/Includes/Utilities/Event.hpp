@@ -0,0 +1,82 @@
+#ifndef _LIBRARY_UTILITIES_EVENT_HPP
+#define _LIBRARY_UTILITIES_EVENT_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace Utilities
+{
+    /*
+     *  condition-variable-like event built as an eventcount on std::atomic::wait.
+     *
+     *  - waiters register before their last predicate check, notifiers skip the
+     *    wake-up (and its syscall) when nobody is registered.
+     *  - the notifier doesn't need the waiter's lock: a state change published before
+     *    notify_*( ) is either seen by the waiter's re-check or wakes it.
+     *  - works with any lock type, wakeups may be spurious (the predicate is re-checked).
+     */
+    class Event
+    {
+        std::atomic<uint32_t> m_epoch{0};
+        std::atomic<uint32_t> m_waiters{0};
+
+        bool has_waiters() const noexcept
+        {
+            // pairs with the fence in wait( ): we see the waiter, or it sees our state change
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return m_waiters.load(std::memory_order_relaxed) != 0;
+        }
+
+    public:
+        Event() = default;
+        ~Event() = default;
+
+        Event(const Event&) = delete;
+        Event& operator=(const Event&) = delete;
+        Event(Event&&) = delete;
+        Event& operator=(Event&&) = delete;
+
+        // lock is held on entry and on return, like std::condition_variable::wait
+        template<typename Lock, typename Predicate>
+        void wait(Lock& lock, Predicate ready)
+        {
+            while (!ready())
+            {
+                m_waiters.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                const auto epoch = m_epoch.load(std::memory_order_acquire);
+                if (ready())
+                {
+                    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                lock.unlock();
+                m_epoch.wait(epoch, std::memory_order_acquire);
+                m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                lock.lock();
+            }
+        }
+
+        void notify_one() noexcept
+        {
+            if (!has_waiters())
+                return;
+
+            m_epoch.fetch_add(1, std::memory_order_release);
+            m_epoch.notify_one();
+        }
+
+        void notify_all() noexcept
+        {
+            if (!has_waiters())
+                return;
+
+            m_epoch.fetch_add(1, std::memory_order_release);
+            m_epoch.notify_all();
+        }
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_EVENT_HPP
@@ -0,0 +1,102 @@
+#ifndef _LIBRARY_UTILITIES_MUTEX_HPP
+#define _LIBRARY_UTILITIES_MUTEX_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace Utilities
+{
+    // tells the core we are spinning, frees pipeline resources for an SMT sibling
+    inline void cpu_relax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
+    // on a single core the lock holder can't run while we spin, so park right away
+    inline bool spinning_pays() noexcept
+    {
+        static const bool multicore = std::thread::hardware_concurrency() > 1;
+        return multicore;
+    }
+
+    /*
+     *  adaptive mutex: spins for a while, then parks on the lock word with
+     *  std::atomic::wait (a futex on Linux).
+     *
+     *  - uncontended lock / unlock is one CAS / one exchange, no syscall.
+     *  - the spin budget follows how long recent acquisitions took to succeed, like
+     *    glibc's PTHREAD_MUTEX_ADAPTIVE_NP: short critical sections are waited out,
+     *    long ones go to sleep quickly.
+     *  - unlock only wakes a thread when one may be parked.
+     *  - not recursive, compatible with std::lock_guard and std::unique_lock.
+     */
+    class Mutex
+    {
+        static constexpr uint32_t unlocked = 0;
+        static constexpr uint32_t locked = 1;
+        static constexpr uint32_t contended = 2;  // locked, and someone may be parked
+
+        static constexpr int32_t max_spins = 256;
+
+        std::atomic<uint32_t> m_state{unlocked};
+        std::atomic<int32_t> m_spins{0};  // moving average of the spins a successful lock needed
+
+        void lock_slow() noexcept
+        {
+            const auto average = m_spins.load(std::memory_order_relaxed);
+            const auto budget = spinning_pays() ? std::min(max_spins, average * 2 + 10) : 0;
+
+            for (int32_t spin = 0; spin < budget; ++spin)
+            {
+                cpu_relax();
+                if (m_state.load(std::memory_order_relaxed) == unlocked && try_lock())
+                {
+                    m_spins.store(average + (spin - average) / 8, std::memory_order_relaxed);
+                    return;
+                }
+            }
+
+            m_spins.store(average + (budget - average) / 8, std::memory_order_relaxed);
+
+            // from here on the lock word says contended, so our unlock wakes the next sleeper
+            while (m_state.exchange(contended, std::memory_order_acquire) != unlocked)
+                m_state.wait(contended, std::memory_order_relaxed);
+        }
+
+    public:
+        Mutex() = default;
+        ~Mutex() = default;
+
+        Mutex(const Mutex&) = delete;
+        Mutex& operator=(const Mutex&) = delete;
+        Mutex(Mutex&&) = delete;
+        Mutex& operator=(Mutex&&) = delete;
+
+        void lock() noexcept
+        {
+            if (!try_lock())
+                lock_slow();
+        }
+
+        bool try_lock() noexcept
+        {
+            auto expected = unlocked;
+            return m_state.compare_exchange_strong(
+                expected, locked, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        void unlock() noexcept
+        {
+            if (m_state.exchange(unlocked, std::memory_order_release) == contended)
+                m_state.notify_one();
+        }
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_MUTEX_HPP
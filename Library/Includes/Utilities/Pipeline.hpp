@@ -0,0 +1,469 @@
+#ifndef _LIBRARY_UTILITIES_PIPELINE_HPP
+#define _LIBRARY_UTILITIES_PIPELINE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Utilities/ThreadPool.hpp"
+
+namespace Utilities
+{
+    enum class StageMode : unsigned char
+    {
+        Parallel,          // any number of items at once
+        SerialInOrder,     // one item at a time, in the order the source produced them
+        SerialOutOfOrder,  // one item at a time, in arrival order
+    };
+
+    namespace detail
+    {
+        // move-only type erased value with inline storage, one per token
+        class PipelineSlot
+        {
+            static constexpr size_t inline_size = 48;
+
+            alignas(std::max_align_t) std::array<std::byte, inline_size> m_buffer;
+            void* m_object = nullptr;
+            void (*m_destroy)(void*) noexcept = nullptr;
+
+            template<typename T>
+            static constexpr bool fits_inline = sizeof(T) <= inline_size && alignof(T) <= alignof(std::max_align_t) &&
+                                                std::is_nothrow_move_constructible_v<T>;
+
+        public:
+            PipelineSlot() = default;
+
+            ~PipelineSlot()
+            {
+                reset();
+            }
+
+            PipelineSlot(const PipelineSlot&) = delete;
+            PipelineSlot& operator=(const PipelineSlot&) = delete;
+            PipelineSlot(PipelineSlot&&) = delete;
+            PipelineSlot& operator=(PipelineSlot&&) = delete;
+
+            template<typename T>
+            void emplace(T&& value)
+            {
+                using Value = std::remove_cvref_t<T>;
+                reset();
+
+                if constexpr (fits_inline<Value>)
+                {
+                    m_object = ::new (static_cast<void*>(m_buffer.data())) Value(std::forward<T>(value));
+                    m_destroy = [](void* object) noexcept { static_cast<Value*>(object)->~Value(); };
+                }
+                else
+                {
+                    m_object = new Value(std::forward<T>(value));
+                    m_destroy = [](void* object) noexcept { delete static_cast<Value*>(object); };
+                }
+            }
+
+            // moves the value out, T must be the emplaced type
+            template<typename T>
+            T take()
+            {
+                T value(std::move(*static_cast<T*>(m_object)));
+                reset();
+                return value;
+            }
+
+            void reset() noexcept
+            {
+                if (m_object == nullptr)
+                    return;
+
+                m_destroy(m_object);
+                m_object = nullptr;
+            }
+        };
+
+        struct PipelineToken
+        {
+            size_t sequence = 0;
+            PipelineSlot value;
+        };
+
+        struct PipelineStage
+        {
+            const StageMode mode;
+
+            // serial stages only
+            std::mutex lock;
+            bool busy = false;
+            size_t next_sequence = 0;           // SerialInOrder: the token allowed in next
+            std::deque<PipelineToken*> parked;  // tokens that arrived while busy, by sequence if in order
+
+            explicit PipelineStage(const StageMode stage_mode)
+                : mode(stage_mode)
+            {
+            }
+
+            virtual ~PipelineStage() = default;
+
+            PipelineStage(const PipelineStage&) = delete;
+            PipelineStage& operator=(const PipelineStage&) = delete;
+            PipelineStage(PipelineStage&&) = delete;
+            PipelineStage& operator=(PipelineStage&&) = delete;
+
+            // false only from the source, when it has nothing left
+            virtual bool process(PipelineToken& token) = 0;
+        };
+
+        template<typename T, typename Fn>
+        struct SourceStage final : PipelineStage
+        {
+            Fn source;
+
+            explicit SourceStage(Fn callable)
+                : PipelineStage(StageMode::SerialOutOfOrder)
+                , source(std::move(callable))
+            {
+            }
+
+            bool process(PipelineToken& token) override
+            {
+                auto item = source();
+                if (!item)
+                    return false;
+
+                token.value.emplace(std::move(*item));
+                return true;
+            }
+        };
+
+        template<typename In, typename Fn>
+        struct TransformStage final : PipelineStage
+        {
+            using Out = std::invoke_result_t<Fn&, In&&>;
+
+            Fn transform;
+
+            TransformStage(const StageMode stage_mode, Fn callable)
+                : PipelineStage(stage_mode)
+                , transform(std::move(callable))
+            {
+            }
+
+            bool process(PipelineToken& token) override
+            {
+                if constexpr (std::is_void_v<Out>)
+                    transform(token.value.take<In>());
+                else
+                    token.value.emplace(transform(token.value.take<In>()));
+
+                return true;
+            }
+        };
+    }  // namespace detail
+
+    template<typename T>
+    class PipelineBuilder;
+
+    /*
+     *  token based stream pipeline on a ThreadPool, like tbb::parallel_pipeline.
+     *
+     *  - a fixed number of tokens circulates: the source fills a free token, the token
+     *    carries its item through every stage and returns to the source after the sink.
+     *    at most `tokens` items are in flight, which bounds memory and queueing.
+     *  - a worker keeps a token moving through consecutive stages itself. a token that
+     *    reaches a busy serial stage is parked there and resumed by the token leaving it.
+     *  - items move from stage to stage, small ones are stored inline in the token.
+     *  - the first exception stops the source. items after the failing one skip the
+     *    remaining stages, earlier ones still complete. run( ) rethrows the exception.
+     *  - built with make_pipeline( ), must not be destroyed while a run is in progress.
+     */
+    class Pipeline
+    {
+        template<typename T>
+        friend class PipelineBuilder;
+
+        std::vector<std::unique_ptr<detail::PipelineStage>> m_stages;
+        std::unique_ptr<detail::PipelineToken[]> m_tokens;
+        size_t m_token_count;
+
+        static constexpr size_t no_failure = std::numeric_limits<size_t>::max();
+
+        ThreadPool* m_pool = nullptr;
+        size_t m_next_sequence = 0;  // owned by the source stage
+        bool m_exhausted = false;    // owned by the source stage
+        std::atomic<size_t> m_live{0};
+        std::atomic<size_t> m_failed_at{no_failure};  // sequence of the item that threw first
+        std::exception_ptr m_error;
+
+        Pipeline(std::vector<std::unique_ptr<detail::PipelineStage>>&& stages, const size_t tokens)
+            : m_stages(std::move(stages))
+            , m_tokens(std::make_unique<detail::PipelineToken[]>(tokens))
+            , m_token_count(tokens)
+        {
+        }
+
+        // true = the token owns the serial stage now, false = parked
+        static bool enter(detail::PipelineStage& stage, detail::PipelineToken& token)
+        {
+            std::lock_guard<std::mutex> guard(stage.lock);
+            const bool in_order = stage.mode == StageMode::SerialInOrder;
+
+            if (!stage.busy && (!in_order || token.sequence == stage.next_sequence))
+            {
+                stage.busy = true;
+                return true;
+            }
+
+            if (!in_order)
+            {
+                stage.parked.push_back(&token);
+                return false;
+            }
+
+            const auto position =
+                std::upper_bound(stage.parked.begin(),
+                                 stage.parked.end(),
+                                 token.sequence,
+                                 [](const size_t sequence, const auto* other) { return sequence < other->sequence; });
+            stage.parked.insert(position, &token);
+            return false;
+        }
+
+        // hands the serial stage to the next parked token that may enter it
+        void leave(detail::PipelineStage& stage, const size_t index)
+        {
+            detail::PipelineToken* next = nullptr;
+            {
+                std::lock_guard<std::mutex> guard(stage.lock);
+                const bool in_order = stage.mode == StageMode::SerialInOrder;
+                if (in_order)
+                    ++stage.next_sequence;
+
+                if (!stage.parked.empty() && (!in_order || stage.parked.front()->sequence == stage.next_sequence))
+                {
+                    next = stage.parked.front();
+                    stage.parked.pop_front();
+                }
+                else
+                {
+                    stage.busy = false;
+                }
+            }
+
+            if (next != nullptr)
+                m_pool->post([this, next, index]() noexcept { advance(*next, index, true); });
+        }
+
+        // false = the source produced nothing, the token retires
+        bool execute(detail::PipelineStage& stage, detail::PipelineToken& token, const bool source) noexcept
+        {
+            if (source && m_exhausted)
+                return false;
+
+            // items from the failing one on only pass through, so in-order stages still see every sequence
+            if (const auto failed_at = m_failed_at.load(std::memory_order_relaxed); failed_at != no_failure)
+            {
+                if (source)
+                {
+                    m_exhausted = true;
+                    return false;
+                }
+
+                if (token.sequence >= failed_at)
+                {
+                    token.value.reset();
+                    return true;
+                }
+            }
+
+            try
+            {
+                if (!stage.process(token))
+                {
+                    m_exhausted = true;
+                    return false;
+                }
+
+                if (source)
+                    token.sequence = m_next_sequence++;
+            }
+            catch (...)
+            {
+                token.value.reset();
+
+                // a failing source has no sequence yet, it would have been the next one
+                auto expected = no_failure;
+                if (m_failed_at.compare_exchange_strong(
+                        expected, source ? m_next_sequence : token.sequence, std::memory_order_relaxed))
+                    m_error = std::current_exception();
+
+                if (source)
+                {
+                    m_exhausted = true;
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // moves `token` through the stages from `index` on, `entered` = it already owns that stage
+        void advance(detail::PipelineToken& token, size_t index, bool entered) noexcept
+        {
+            while (true)
+            {
+                auto& stage = *m_stages[index];
+                const bool serial = stage.mode != StageMode::Parallel;
+
+                if (serial && !entered && !enter(stage, token))
+                    return;  // parked, whoever leaves the stage resumes it
+
+                const bool produced = execute(stage, token, index == 0);
+                if (serial)
+                    leave(stage, index);
+
+                if (!produced)
+                {
+                    // like TaskGraph: the last retiring token is the last touch of the pipeline
+                    if (m_live.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        m_live.notify_all();
+                    return;
+                }
+
+                // after the sink the token goes back to the source
+                index = (index + 1) % m_stages.size();
+                entered = false;
+            }
+        }
+
+    public:
+        ~Pipeline() = default;
+
+        Pipeline(const Pipeline&) = delete;
+        Pipeline& operator=(const Pipeline&) = delete;
+        Pipeline(Pipeline&&) = delete;
+        Pipeline& operator=(Pipeline&&) = delete;
+
+        size_t tokens() const
+        {
+            return m_token_count;
+        }
+
+        size_t stages() const
+        {
+            return m_stages.size();
+        }
+
+        /*
+         *  pulls the source dry and blocks until every item left the sink. may be called
+         *  again, e.g. once the source has new input. must not be called from a worker
+         *  of the same pool.
+         */
+        void run(ThreadPool& pool)
+        {
+            for (auto& stage : m_stages)
+            {
+                stage->busy = false;
+                stage->next_sequence = 0;
+                stage->parked.clear();
+            }
+
+            m_pool = &pool;
+            m_next_sequence = 0;
+            m_exhausted = false;
+            m_error = nullptr;
+            m_failed_at.store(no_failure, std::memory_order_relaxed);
+            m_live.store(m_token_count, std::memory_order_release);
+
+            for (size_t i = 0; i < m_token_count; ++i)
+            {
+                auto* token = &m_tokens[i];
+                pool.post([this, token]() noexcept { advance(*token, 0, false); });
+            }
+
+            for (auto live = m_live.load(std::memory_order_acquire); live != 0;
+                 live = m_live.load(std::memory_order_acquire))
+                m_live.wait(live, std::memory_order_acquire);
+
+            if (m_error)
+                std::rethrow_exception(m_error);
+        }
+    };
+
+    /*
+     *  typed builder, T is the item type the next stage receives. every call consumes
+     *  the builder:
+     *      auto pipeline = make_pipeline( 16, read_record )
+     *                          .then( StageMode::Parallel, parse )
+     *                          .sink( StageMode::SerialInOrder, write );
+     */
+    template<typename T>
+    class PipelineBuilder
+    {
+        template<typename U>
+        friend class PipelineBuilder;
+
+        template<typename Fn>
+        friend auto make_pipeline(size_t tokens, Fn source);
+
+        std::vector<std::unique_ptr<detail::PipelineStage>> m_stages;
+        size_t m_tokens;
+
+        PipelineBuilder(std::vector<std::unique_ptr<detail::PipelineStage>>&& stages, const size_t tokens)
+            : m_stages(std::move(stages))
+            , m_tokens(tokens)
+        {
+        }
+
+    public:
+        // adds a stage that turns a T into whatever `transform` returns
+        template<typename Fn>
+            requires(std::invocable<Fn&, T&&> && std::movable<std::invoke_result_t<Fn&, T&&>>)
+        auto then(const StageMode mode, Fn transform) &&
+        {
+            m_stages.push_back(std::make_unique<detail::TransformStage<T, Fn>>(mode, std::move(transform)));
+            return PipelineBuilder<std::invoke_result_t<Fn&, T&&>>(std::move(m_stages), m_tokens);
+        }
+
+        // adds the last stage, its result (if any) is dropped
+        template<typename Fn>
+            requires(std::invocable<Fn&, T&&>)
+        Pipeline sink(const StageMode mode, Fn consume) &&
+        {
+            auto last = [consume = std::move(consume)](T&& item) mutable { consume(std::move(item)); };
+            m_stages.push_back(std::make_unique<detail::TransformStage<T, decltype(last)>>(mode, std::move(last)));
+            return Pipeline(std::move(m_stages), m_tokens);
+        }
+    };
+
+    /*
+     *  starts a pipeline. `source` is called serially and returns std::optional<item>,
+     *  an empty optional ends the stream. `tokens` caps the items in flight.
+     */
+    template<typename Fn>
+    auto make_pipeline(const size_t tokens, Fn source)
+    {
+        using Item = typename std::invoke_result_t<Fn&>::value_type;
+
+        if (tokens == 0)
+            throw std::invalid_argument("Pipeline: needs at least one token");
+
+        std::vector<std::unique_ptr<detail::PipelineStage>> stages;
+        stages.push_back(std::make_unique<detail::SourceStage<Item, Fn>>(std::move(source)));
+        return PipelineBuilder<Item>(std::move(stages), tokens);
+    }
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_PIPELINE_HPP
@@ -0,0 +1,87 @@
+#ifndef _LIBRARY_UTILITIES_SEMAPHORE_HPP
+#define _LIBRARY_UTILITIES_SEMAPHORE_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "Utilities/Mutex.hpp"
+
+namespace Utilities
+{
+    /*
+     *  counting semaphore on std::atomic::wait.
+     *
+     *  - acquire( ) spins briefly on a zero count before parking.
+     *  - release( ) only issues a wake-up when a thread is parked, so the common
+     *    producer-ahead-of-consumer case is a single atomic add.
+     */
+    class Semaphore
+    {
+        static constexpr int spin_limit = 64;
+
+        std::atomic<uint32_t> m_count;
+        std::atomic<uint32_t> m_waiters{0};
+
+    public:
+        explicit Semaphore(const uint32_t initial = 0)
+            : m_count(initial)
+        {
+        }
+
+        ~Semaphore() = default;
+
+        Semaphore(const Semaphore&) = delete;
+        Semaphore& operator=(const Semaphore&) = delete;
+        Semaphore(Semaphore&&) = delete;
+        Semaphore& operator=(Semaphore&&) = delete;
+
+        bool try_acquire() noexcept
+        {
+            auto count = m_count.load(std::memory_order_relaxed);
+            while (count != 0)
+                if (m_count.compare_exchange_weak(
+                        count, count - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                    return true;
+
+            return false;
+        }
+
+        void acquire() noexcept
+        {
+            for (int spin = 0; spin < spin_limit && spinning_pays(); ++spin)
+            {
+                if (try_acquire())
+                    return;
+                cpu_relax();
+            }
+
+            while (!try_acquire())
+            {
+                m_waiters.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                // pairs with the fence in release( ): it sees us, or we see its count
+                if (m_count.load(std::memory_order_relaxed) == 0)
+                    m_count.wait(0, std::memory_order_relaxed);
+
+                m_waiters.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        void release(const uint32_t count = 1) noexcept
+        {
+            m_count.fetch_add(count, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (m_waiters.load(std::memory_order_relaxed) == 0)
+                return;
+
+            if (count == 1)
+                m_count.notify_one();
+            else
+                m_count.notify_all();
+        }
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_SEMAPHORE_HPP
@@ -0,0 +1,229 @@
+#ifndef _LIBRARY_UTILITIES_SHARDEDCOUNTER_HPP
+#define _LIBRARY_UTILITIES_SHARDEDCOUNTER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include "Utilities/CacheLine.hpp"
+
+namespace Utilities
+{
+    // what the containers need from their size counter
+    template<typename Counter>
+    concept CounterPolicy = std::default_initializable<Counter> && requires(Counter counter, const Counter& view) {
+        counter.increment();
+        counter.decrement();
+        { view.load() } -> std::convertible_to<int64_t>;
+    };
+
+    namespace detail
+    {
+        // threads get consecutive shard numbers the first time they touch any sharded type
+        inline size_t thread_shard() noexcept
+        {
+            static std::atomic<size_t> next{0};
+            thread_local const size_t shard = next.fetch_add(1, std::memory_order_relaxed);
+            return shard;
+        }
+
+        inline size_t default_shards() noexcept
+        {
+            return std::bit_ceil(size_t{std::max(1u, std::thread::hardware_concurrency())});
+        }
+    }  // namespace detail
+
+    // one shared atomic: exact reads, every update contends on the same cache line
+    class AtomicCounter
+    {
+        std::atomic<int64_t> m_value{0};
+
+    public:
+        void add(const int64_t delta) noexcept
+        {
+            m_value.fetch_add(delta);
+        }
+
+        void increment() noexcept
+        {
+            ++m_value;
+        }
+
+        void decrement() noexcept
+        {
+            --m_value;
+        }
+
+        int64_t load() const noexcept
+        {
+            return m_value.load();
+        }
+    };
+
+    /*
+     *  counter split into cache-line-padded cells, each thread updates its own cell.
+     *
+     *  - updates are a relaxed fetch_add on a line no other thread writes (as long as
+     *    there are no more threads than shards), so they scale with the core count.
+     *  - load( ) sums every cell: O(shards), and only approximate while updates are in
+     *    flight. it is exact once all updates happen-before the read.
+     *  - use AtomicCounter where a read must be exact under concurrency.
+     */
+    class ShardedCounter
+    {
+        std::unique_ptr<CachePadded<std::atomic<int64_t>>[]> m_cells;
+        const size_t m_mask;
+
+        std::atomic<int64_t>& local_cell() noexcept
+        {
+            return m_cells[detail::thread_shard() & m_mask].value;
+        }
+
+    public:
+        // rounded up to a power of two, defaults to one shard per hardware thread
+        explicit ShardedCounter(const size_t shards = detail::default_shards())
+            : m_cells(std::make_unique<CachePadded<std::atomic<int64_t>>[]>(std::bit_ceil(std::max(shards, size_t{1}))))
+            , m_mask(std::bit_ceil(std::max(shards, size_t{1})) - 1)
+        {
+        }
+
+        ShardedCounter(const ShardedCounter&) = delete;
+        ShardedCounter& operator=(const ShardedCounter&) = delete;
+        ShardedCounter(ShardedCounter&&) = delete;
+        ShardedCounter& operator=(ShardedCounter&&) = delete;
+        ~ShardedCounter() = default;
+
+        void add(const int64_t delta) noexcept
+        {
+            local_cell().fetch_add(delta, std::memory_order_relaxed);
+        }
+
+        void increment() noexcept
+        {
+            add(1);
+        }
+
+        void decrement() noexcept
+        {
+            add(-1);
+        }
+
+        int64_t load() const noexcept
+        {
+            int64_t total = 0;
+            for (size_t shard = 0; shard <= m_mask; ++shard)
+                total += m_cells[shard].value.load(std::memory_order_relaxed);
+
+            return total;
+        }
+
+        size_t shards() const noexcept
+        {
+            return m_mask + 1;
+        }
+    };
+
+    /*
+     *  count / sum / min / max of recorded samples, sharded like ShardedCounter.
+     *  summary( ) merges the shards, with the same consistency as ShardedCounter::load( ).
+     */
+    template<typename T = int64_t>
+        requires(std::is_arithmetic_v<T>)
+    class ShardedAccumulator
+    {
+    public:
+        struct Summary
+        {
+            uint64_t count = 0;
+            T sum = 0;
+            T min = std::numeric_limits<T>::max();  // min and max only hold samples when count > 0
+            T max = std::numeric_limits<T>::lowest();
+
+            double mean() const noexcept
+            {
+                return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+            }
+        };
+
+    private:
+        struct alignas(cache_line_size) Cell
+        {
+            std::atomic<uint64_t> count{0};
+            std::atomic<T> sum{0};
+            std::atomic<T> min{std::numeric_limits<T>::max()};
+            std::atomic<T> max{std::numeric_limits<T>::lowest()};
+        };
+
+        std::unique_ptr<Cell[]> m_cells;
+        const size_t m_mask;
+
+    public:
+        explicit ShardedAccumulator(const size_t shards = detail::default_shards())
+            : m_cells(std::make_unique<Cell[]>(std::bit_ceil(std::max(shards, size_t{1}))))
+            , m_mask(std::bit_ceil(std::max(shards, size_t{1})) - 1)
+        {
+        }
+
+        ShardedAccumulator(const ShardedAccumulator&) = delete;
+        ShardedAccumulator& operator=(const ShardedAccumulator&) = delete;
+        ShardedAccumulator(ShardedAccumulator&&) = delete;
+        ShardedAccumulator& operator=(ShardedAccumulator&&) = delete;
+        ~ShardedAccumulator() = default;
+
+        void record(const T value) noexcept
+        {
+            auto& cell = m_cells[detail::thread_shard() & m_mask];
+
+            cell.count.fetch_add(1, std::memory_order_relaxed);
+            cell.sum.fetch_add(value, std::memory_order_relaxed);
+
+            // the cell is normally written by one thread only, so these rarely retry
+            for (auto low = cell.min.load(std::memory_order_relaxed);
+                 value < low && !cell.min.compare_exchange_weak(low, value, std::memory_order_relaxed);)
+            {
+            }
+
+            for (auto high = cell.max.load(std::memory_order_relaxed);
+                 value > high && !cell.max.compare_exchange_weak(high, value, std::memory_order_relaxed);)
+            {
+            }
+        }
+
+        Summary summary() const noexcept
+        {
+            Summary merged;
+            for (size_t shard = 0; shard <= m_mask; ++shard)
+            {
+                const auto& cell = m_cells[shard];
+                merged.count += cell.count.load(std::memory_order_relaxed);
+                merged.sum += cell.sum.load(std::memory_order_relaxed);
+                merged.min = std::min(merged.min, cell.min.load(std::memory_order_relaxed));
+                merged.max = std::max(merged.max, cell.max.load(std::memory_order_relaxed));
+            }
+
+            return merged;
+        }
+
+        // samples recorded concurrently with a reset may survive it partially
+        void reset() noexcept
+        {
+            for (size_t shard = 0; shard <= m_mask; ++shard)
+            {
+                auto& cell = m_cells[shard];
+                cell.count.store(0, std::memory_order_relaxed);
+                cell.sum.store(0, std::memory_order_relaxed);
+                cell.min.store(std::numeric_limits<T>::max(), std::memory_order_relaxed);
+                cell.max.store(std::numeric_limits<T>::lowest(), std::memory_order_relaxed);
+            }
+        }
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_SHARDEDCOUNTER_HPP
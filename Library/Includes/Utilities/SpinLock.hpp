@@ -4,9 +4,12 @@
 #include <atomic>
 #include <thread>
 
+#include "Utilities/CacheLine.hpp"
+
 namespace Utilities
 {
-    class SpinLock
+    // padded to a cache line, spinning on one lock doesn't slow down the owner of its neighbour
+    class alignas(cache_line_size) SpinLock
     {
         std::atomic<bool> m_lock{false};
 
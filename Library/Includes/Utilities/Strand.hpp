@@ -0,0 +1,158 @@
+#ifndef _LIBRARY_UTILITIES_STRAND_HPP
+#define _LIBRARY_UTILITIES_STRAND_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "Utilities/ThreadPool.hpp"
+
+namespace Utilities
+{
+    /*
+     *  serial executor on top of a ThreadPool: callables posted to one strand run one
+     *  at a time in FIFO order, different strands run in parallel.
+     *
+     *  - an idle strand holds no thread and no queue slot, it is four words.
+     *  - post( ) is lock-free: a counter bump plus a push onto an intrusive stack. the
+     *    poster that makes the strand non-empty schedules a drain on the pool.
+     *  - a drain runs up to `batch_limit` callables back to back, then yields the worker
+     *    by re-posting itself if more work is pending.
+     *  - callables must not throw. the destructor waits until the work posted so far has
+     *    run and the drain let go of the strand, so it must not run on that strand.
+     */
+    class Strand
+    {
+        struct Node
+        {
+            Node* next = nullptr;
+
+            Node() = default;
+            Node(const Node&) = delete;
+            Node& operator=(const Node&) = delete;
+            Node(Node&&) = delete;
+            Node& operator=(Node&&) = delete;
+            virtual ~Node() = default;
+
+            virtual void run() = 0;
+        };
+
+        template<typename Fn>
+        struct Task final : Node
+        {
+            Fn callable;
+
+            explicit Task(Fn&& fn)
+                : callable(std::move(fn))
+            {
+            }
+
+            void run() override
+            {
+                callable();
+            }
+        };
+
+        static constexpr size_t batch_limit = 64;
+
+        ThreadPool* m_pool;
+        std::atomic<Node*> m_incoming{nullptr};  // LIFO, reversed by the drain
+        std::atomic<size_t> m_pending{0};        // posted and not yet run
+
+        // only touched by the single running drain
+        Node* m_ready = nullptr;
+
+        static Node* reverse(Node* head)
+        {
+            Node* reversed = nullptr;
+            while (head != nullptr)
+            {
+                auto* next = head->next;
+                head->next = reversed;
+                reversed = head;
+                head = next;
+            }
+
+            return reversed;
+        }
+
+        void schedule()
+        {
+            m_pool->post([this]() noexcept { drain(); });
+        }
+
+        void drain()
+        {
+            size_t ran = 0;
+
+            while (ran < batch_limit)
+            {
+                if (m_ready == nullptr)
+                {
+                    m_ready = reverse(m_incoming.exchange(nullptr, std::memory_order_acquire));
+                    if (m_ready == nullptr)
+                        break;
+                }
+
+                auto* node = m_ready;
+                m_ready = node->next;
+
+                node->run();
+                delete node;
+                ++ran;
+            }
+
+            // posters count before they push, so pending work may not be visible yet:
+            // the strand stays scheduled until the counter drops to zero
+            if (m_pending.fetch_sub(ran, std::memory_order_acq_rel) != ran)
+                schedule();
+            else
+                m_pending.notify_all();  // the destructor may free the strand from here on
+        }
+
+    public:
+        explicit Strand(ThreadPool& pool) noexcept
+            : m_pool(&pool)
+        {
+        }
+
+        Strand(const Strand&) = delete;
+        Strand& operator=(const Strand&) = delete;
+        Strand(Strand&&) = delete;
+        Strand& operator=(Strand&&) = delete;
+
+        ~Strand()
+        {
+            for (auto pending = m_pending.load(std::memory_order_acquire); pending != 0;
+                 pending = m_pending.load(std::memory_order_acquire))
+                m_pending.wait(pending, std::memory_order_acquire);
+        }
+
+        template<typename Fn>
+        void post(Fn callable)
+        {
+            Node* node = new Task<Fn>(std::move(callable));
+
+            // counting first keeps a drain from ever running a node nobody counted yet,
+            // so only the 0 -> 1 transition (no drain alive) schedules one
+            const auto was_idle = m_pending.fetch_add(1, std::memory_order_acq_rel) == 0;
+
+            node->next = m_incoming.load(std::memory_order_relaxed);
+            while (!m_incoming.compare_exchange_weak(
+                node->next, node, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+
+            if (was_idle)
+                schedule();
+        }
+
+        // nothing posted is waiting or running
+        bool idle() const
+        {
+            return m_pending.load(std::memory_order_acquire) == 0;
+        }
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_STRAND_HPP
@@ -0,0 +1,48 @@
+#ifndef _LIBRARY_UTILITIES_SYNCPOLICY_HPP
+#define _LIBRARY_UTILITIES_SYNCPOLICY_HPP
+
+#include <concepts>
+#include <condition_variable>
+#include <mutex>
+
+#include "Utilities/Event.hpp"
+#include "Utilities/Mutex.hpp"
+
+namespace Utilities
+{
+    /*
+     *  picks the lock and the wait / notify primitive of a blocking container.
+     *
+     *  - condition_type::wait( std::unique_lock<mutex_type>&, predicate ), notify_one( ), notify_all( ).
+     *  - lock_free_notify: a notify is never lost, even when the notifier doesn't hold
+     *    the waiter's lock. otherwise the container has to hand the lock over itself.
+     */
+    template<typename Policy>
+    concept SyncPolicy = requires {
+        typename Policy::mutex_type;
+        typename Policy::condition_type;
+        { Policy::lock_free_notify } -> std::convertible_to<bool>;
+    };
+
+    /*
+     *  std::mutex + std::condition_variable. a notify can be lost without the waiter's lock,
+     *  so the container counts its waiters: a push pays a fence, and a lock hand-over plus a
+     *  notify only while a consumer is parked.
+     */
+    struct StdSyncPolicy
+    {
+        using mutex_type = std::mutex;
+        using condition_type = std::condition_variable;
+        static constexpr bool lock_free_notify = false;
+    };
+
+    // spin-then-park Mutex + waiter counting Event, notifies nobody is waiting for are free
+    struct AdaptiveSyncPolicy
+    {
+        using mutex_type = Mutex;
+        using condition_type = Event;
+        static constexpr bool lock_free_notify = true;
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_SYNCPOLICY_HPP
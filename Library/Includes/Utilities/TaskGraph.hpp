@@ -0,0 +1,268 @@
+#ifndef _LIBRARY_UTILITIES_TASKGRAPH_HPP
+#define _LIBRARY_UTILITIES_TASKGRAPH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Utilities/FunctionWrapper.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+namespace Utilities
+{
+    /*
+     *  dependency graph of callables, executed on a ThreadPool.
+     *
+     *  - every node keeps an atomic count of unfinished predecessors. the predecessor
+     *    that drops it to zero schedules the node: one ready successor runs inline on the
+     *    same worker, the others are posted to the pool.
+     *  - build once, run many times: run( ) only resets counters, nothing is allocated
+     *    by the graph itself (the pool still wraps each posted node).
+     *  - a node that throws cancels everything downstream of it, independent branches
+     *    still finish. run( ) rethrows the first exception.
+     *  - the graph must not be modified or destroyed while a run is in progress, and
+     *    run( ) must not be called from a worker of the same pool (it blocks).
+     */
+    class TaskGraph
+    {
+    public:
+        using TaskId = size_t;
+
+        // barrier nodes around a spliced graph, connect edges to these
+        struct Subgraph
+        {
+            TaskId entry = 0;
+            TaskId exit = 0;
+        };
+
+    private:
+        struct Node
+        {
+            FunctionWrapper work;
+            std::vector<TaskId> successors;
+            size_t dependencies = 0;
+
+            std::atomic<size_t> pending{0};      // unfinished predecessors in this run
+            std::atomic<bool> cancelled{false};  // a predecessor failed or was cancelled
+
+            explicit Node(FunctionWrapper&& callable) noexcept
+                : work(std::move(callable))
+            {
+            }
+        };
+
+        std::deque<Node> m_nodes;  // stable addresses, nodes hold atomics
+        std::vector<TaskId> m_roots;
+        bool m_validated = false;
+
+        ThreadPool* m_pool = nullptr;
+        std::atomic<size_t> m_remaining{0};
+        std::atomic<bool> m_failed{false};
+        std::exception_ptr m_error;
+
+        Node& node_at(const TaskId id)
+        {
+            if (id >= m_nodes.size())
+                throw std::out_of_range("TaskGraph: unknown task id");
+
+            return m_nodes[id];
+        }
+
+        // Kahn's algorithm, only after the graph changed
+        void validate()
+        {
+            if (m_validated)
+                return;
+
+            std::vector<size_t> in_degree(m_nodes.size());
+            for (const auto& node : m_nodes)
+                for (const auto successor : node.successors)
+                    ++in_degree[successor];
+
+            m_roots.clear();
+            for (TaskId id = 0; id < m_nodes.size(); ++id)
+                if (in_degree[id] == 0)
+                    m_roots.push_back(id);
+
+            std::vector<TaskId> ready = m_roots;
+            size_t visited = 0;
+            while (!ready.empty())
+            {
+                const auto id = ready.back();
+                ready.pop_back();
+                ++visited;
+
+                for (const auto successor : m_nodes[id].successors)
+                    if (--in_degree[successor] == 0)
+                        ready.push_back(successor);
+            }
+
+            if (visited != m_nodes.size())
+                throw std::logic_error("TaskGraph: dependency cycle");
+
+            m_validated = true;
+        }
+
+        void schedule(const TaskId id)
+        {
+            m_pool->post([this, id]() noexcept { execute(id); });
+        }
+
+        void execute(TaskId id) noexcept
+        {
+            while (true)
+            {
+                auto& node = m_nodes[id];
+
+                // pending was released by every predecessor, so their cancellations are visible
+                bool cancelled = node.cancelled.load(std::memory_order_relaxed);
+                if (!cancelled)
+                {
+                    try
+                    {
+                        node.work();
+                    }
+                    catch (...)
+                    {
+                        cancelled = true;
+                        if (!m_failed.exchange(true, std::memory_order_relaxed))
+                            m_error = std::current_exception();
+                    }
+                }
+
+                auto next = m_nodes.size();
+                for (const auto successor : node.successors)
+                {
+                    auto& after = m_nodes[successor];
+                    if (cancelled)
+                        after.cancelled.store(true, std::memory_order_relaxed);
+
+                    if (after.pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                        continue;
+
+                    if (next == m_nodes.size())
+                        next = successor;
+                    else
+                        schedule(successor);
+                }
+
+                // with no inline successor this is the last touch of the graph: once the
+                // count hits zero run( ) may return, like std::latch::count_down
+                if (next == m_nodes.size())
+                {
+                    if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        m_remaining.notify_all();
+                    return;
+                }
+
+                m_remaining.fetch_sub(1, std::memory_order_acq_rel);
+                id = next;
+            }
+        }
+
+    public:
+        TaskGraph() = default;
+        ~TaskGraph() = default;
+
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+        TaskGraph(TaskGraph&&) = delete;
+        TaskGraph& operator=(TaskGraph&&) = delete;
+
+        template<typename Fn>
+        TaskId emplace(Fn callable)
+        {
+            m_nodes.emplace_back(FunctionWrapper{std::move(callable)});
+            m_validated = false;
+            return m_nodes.size() - 1;
+        }
+
+        // `after` starts only once `before` finished
+        void precede(const TaskId before, const TaskId after)
+        {
+            auto& target = node_at(after);
+            node_at(before).successors.push_back(after);
+            ++target.dependencies;
+            m_validated = false;
+        }
+
+        /*
+         *  moves every node of `subgraph` into this graph, between an entry node that
+         *  precedes its roots and an exit node that follows its leaves. `subgraph` is left empty.
+         */
+        Subgraph splice(TaskGraph&& subgraph)
+        {
+            subgraph.validate();
+
+            const auto entry = emplace([]() noexcept {});
+            const auto offset = m_nodes.size();
+
+            for (auto& node : subgraph.m_nodes)
+            {
+                auto& moved = m_nodes.emplace_back(std::move(node.work));
+                moved.successors = std::move(node.successors);
+                moved.dependencies = node.dependencies;
+                for (auto& successor : moved.successors)
+                    successor += offset;
+            }
+
+            const auto exit = emplace([]() noexcept {});
+
+            for (const auto root : subgraph.m_roots)
+                precede(entry, root + offset);
+            for (TaskId id = offset; id < exit; ++id)
+                if (m_nodes[id].successors.empty())
+                    precede(id, exit);
+
+            // nothing in between, exit still has to wait for entry
+            if (offset == exit)
+                precede(entry, exit);
+
+            subgraph.m_nodes.clear();
+            subgraph.m_roots.clear();
+            subgraph.m_validated = false;
+
+            return {entry, exit};
+        }
+
+        size_t size() const
+        {
+            return m_nodes.size();
+        }
+
+        // runs every node once and blocks until all finished or got cancelled
+        void run(ThreadPool& pool)
+        {
+            validate();
+            if (m_nodes.empty())
+                return;
+
+            for (auto& node : m_nodes)
+            {
+                node.pending.store(node.dependencies, std::memory_order_relaxed);
+                node.cancelled.store(false, std::memory_order_relaxed);
+            }
+
+            m_pool = &pool;
+            m_error = nullptr;
+            m_failed.store(false, std::memory_order_relaxed);
+            m_remaining.store(m_nodes.size(), std::memory_order_release);
+
+            for (const auto root : m_roots)
+                schedule(root);
+
+            for (auto left = m_remaining.load(std::memory_order_acquire); left != 0;
+                 left = m_remaining.load(std::memory_order_acquire))
+                m_remaining.wait(left, std::memory_order_acquire);
+
+            if (m_error)
+                std::rethrow_exception(m_error);
+        }
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_TASKGRAPH_HPP
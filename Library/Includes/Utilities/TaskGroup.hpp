@@ -0,0 +1,158 @@
+#ifndef _LIBRARY_UTILITIES_TASKGROUP_HPP
+#define _LIBRARY_UTILITIES_TASKGROUP_HPP
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stop_token>
+#include <utility>
+
+#include "DataStructures/SynchronizedQueue.hpp"
+#include "Utilities/FunctionWrapper.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+namespace Utilities
+{
+    /*
+     *  fork/join scope over a ThreadPool.
+     *
+     *  - run( ) queues a callable in the group and posts a ticket to the pool, whoever
+     *    gets to a queued callable first runs it: a pool worker or a thread in wait( ).
+     *  - wait( ) helps: it runs queued callables itself and only blocks while the
+     *    remaining ones are running elsewhere.
+     *  - callables taking a std::stop_token see cancel( ). callables not started yet
+     *    are skipped once the group is cancelled.
+     *  - the first exception cancels the group and is rethrown by wait( ).
+     *  - the destructor cancels and waits, no callable outlives its group.
+     */
+    class TaskGroup
+    {
+        // shared with the tickets, a ticket may run after the group is gone
+        struct State
+        {
+            DataStructures::SynchronizedQueue<FunctionWrapper> queued;
+            std::atomic<size_t> pending{0};  // run( ) and not finished or skipped yet
+            std::stop_source stop;
+
+            std::atomic<bool> failed{false};
+            std::exception_ptr error;
+
+            void finish_one()
+            {
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    pending.notify_all();
+            }
+
+            bool run_one()
+            {
+                auto task = queued.try_pop();
+                if (!task)
+                    return false;
+
+                (*task)();
+                return true;
+            }
+        };
+
+        ThreadPool* m_pool;
+        std::shared_ptr<State> m_state;
+
+    public:
+        explicit TaskGroup(ThreadPool& pool)
+            : m_pool(&pool)
+            , m_state(std::make_shared<State>())
+        {
+        }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        TaskGroup(TaskGroup&&) = delete;
+        TaskGroup& operator=(TaskGroup&&) = delete;
+
+        ~TaskGroup()
+        {
+            cancel();
+            try
+            {
+                wait();
+            }
+            catch (...)
+            {
+                // nobody waited for the result, so nobody gets the exception
+            }
+        }
+
+        // callable() or callable(std::stop_token)
+        template<typename Fn>
+            requires(std::invocable<Fn&> || std::invocable<Fn&, std::stop_token>)
+        void run(Fn callable)
+        {
+            m_state->pending.fetch_add(1, std::memory_order_relaxed);
+            m_state->queued.push(FunctionWrapper{
+                [state = m_state.get(), callable = std::move(callable)]() mutable
+                {
+                    const auto token = state->stop.get_token();
+                    if (!token.stop_requested())
+                    {
+                        try
+                        {
+                            if constexpr (std::invocable<Fn&, std::stop_token>)
+                                callable(token);
+                            else
+                                callable();
+                        }
+                        catch (...)
+                        {
+                            if (!state->failed.exchange(true, std::memory_order_acq_rel))
+                            {
+                                state->error = std::current_exception();
+                                state->stop.request_stop();
+                            }
+                        }
+                    }
+
+                    state->finish_one();
+                }});
+
+            m_pool->post([state = m_state]() noexcept { state->run_one(); });
+        }
+
+        /*
+         *  returns once every callable run so far finished or was skipped, and rethrows the
+         *  first exception (once). may be called repeatedly, a cancelled group stays cancelled.
+         */
+        void wait()
+        {
+            auto& state = *m_state;
+
+            for (auto left = state.pending.load(std::memory_order_acquire); left != 0;
+                 left = state.pending.load(std::memory_order_acquire))
+            {
+                if (!state.run_one())
+                    state.pending.wait(left, std::memory_order_acquire);
+            }
+
+            if (state.failed.exchange(false, std::memory_order_acq_rel))
+                std::rethrow_exception(std::exchange(state.error, nullptr));
+        }
+
+        void cancel() noexcept
+        {
+            m_state->stop.request_stop();
+        }
+
+        bool cancelled() const noexcept
+        {
+            return m_state->stop.stop_requested();
+        }
+
+        std::stop_token stop_token() const noexcept
+        {
+            return m_state->stop.get_token();
+        }
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_TASKGROUP_HPP
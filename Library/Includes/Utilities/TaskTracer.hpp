@@ -0,0 +1,258 @@
+#ifndef _LIBRARY_UTILITIES_TASKTRACER_HPP
+#define _LIBRARY_UTILITIES_TASKTRACER_HPP
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Utilities
+{
+    /*
+     *  collects task execution spans into per-thread ring buffers and writes them
+     *  out as Chrome Trace Event JSON (loads in Perfetto and chrome://tracing).
+     *
+     *  - recording is lock-free: every thread owns a single-producer ring, the
+     *    only lock is taken once per thread when its ring gets registered.
+     *  - flush( ) is the single consumer, it drains whatever has been published.
+     *  - a full ring drops new events instead of blocking the worker, see dropped( ).
+     */
+    class TaskTracer
+    {
+    public:
+        static constexpr size_t default_capacity = 16384;  // events per thread
+
+        struct Event
+        {
+            const char* label = nullptr;  // not copied, must outlive the flush (e.g. a literal)
+            int64_t submit_ns = 0;
+            int64_t start_ns = 0;
+            int64_t end_ns = 0;
+        };
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        class Ring
+        {
+            std::vector<Event> m_events;
+            const size_t m_mask;
+            const size_t m_thread_id;
+
+            std::atomic<size_t> m_head{0};  // advanced by the owning thread only
+            std::atomic<size_t> m_tail{0};  // advanced by the flushing thread only
+            std::atomic<size_t> m_dropped{0};
+
+        public:
+            Ring(size_t capacity, size_t thread_id)
+                : m_events(capacity)
+                , m_mask(capacity - 1)
+                , m_thread_id(thread_id)
+            {
+            }
+
+            void push(const Event& event) noexcept
+            {
+                const auto head = m_head.load(std::memory_order_relaxed);
+                if (head - m_tail.load(std::memory_order_acquire) > m_mask)
+                {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                m_events[head & m_mask] = event;
+                m_head.store(head + 1, std::memory_order_release);
+            }
+
+            template<typename Fn>
+            void drain(Fn&& consume)
+            {
+                auto tail = m_tail.load(std::memory_order_relaxed);
+                const auto head = m_head.load(std::memory_order_acquire);
+
+                for (; tail != head; ++tail)
+                    consume(m_events[tail & m_mask]);
+
+                m_tail.store(tail, std::memory_order_release);
+            }
+
+            size_t thread_id() const
+            {
+                return m_thread_id;
+            }
+
+            size_t dropped() const
+            {
+                return m_dropped.load(std::memory_order_relaxed);
+            }
+        };
+
+        struct Binding
+        {
+            uint64_t tracer_id;
+            Ring* ring;
+            std::weak_ptr<const void> tracer_alive;
+        };
+
+        const uint64_t m_id;
+        const size_t m_capacity;
+        const Clock::time_point m_epoch;
+
+        // expires with the tracer, lets threads drop their bindings to it
+        const std::shared_ptr<const void> m_alive = std::make_shared<const bool>(true);
+
+        // guards registration of new threads and serializes flushes
+        mutable std::mutex m_rings_lock;
+        std::deque<std::unique_ptr<Ring>> m_rings;
+
+        static uint64_t next_id()
+        {
+            static std::atomic<uint64_t> ids{0};
+            return ids.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Ring& local_ring(const size_t thread_id)
+        {
+            // tracer ids are never reused, so a binding to a destroyed tracer
+            // can't be picked up by a new one living at the same address
+            thread_local std::vector<Binding> bindings;
+
+            for (const auto& binding : bindings)
+                if (binding.tracer_id == m_id)
+                    return *binding.ring;
+
+            // once per thread and tracer: forget the tracers destroyed since, so the list stays short
+            std::erase_if(bindings, [](const Binding& binding) noexcept { return binding.tracer_alive.expired(); });
+
+            std::lock_guard<std::mutex> guard(m_rings_lock);
+            auto& ring = m_rings.emplace_back(std::make_unique<Ring>(m_capacity, thread_id));
+            bindings.push_back({m_id, ring.get(), m_alive});
+
+            return *ring;
+        }
+
+        static void write_escaped(std::ostream& out, const char* text)
+        {
+            for (; *text != '\0'; ++text)
+            {
+                const auto ch = static_cast<unsigned char>(*text);
+                if (ch == '"' || ch == '\\')
+                    out << '\\' << *text;
+                else if (ch < 0x20)
+                    out << ' ';
+                else
+                    out << *text;
+            }
+        }
+
+        static void write_micros(std::ostream& out, int64_t nanos)
+        {
+            // chrome trace timestamps are in microseconds, keep ns precision
+            out << nanos / 1000 << '.' << static_cast<char>('0' + (nanos / 100) % 10)
+                << static_cast<char>('0' + (nanos / 10) % 10) << static_cast<char>('0' + nanos % 10);
+        }
+
+    public:
+        explicit TaskTracer(size_t events_per_thread = default_capacity)
+            : m_id(next_id())
+            , m_capacity(std::bit_ceil(events_per_thread < 2 ? size_t{2} : events_per_thread))
+            , m_epoch(Clock::now())
+        {
+        }
+
+        TaskTracer(const TaskTracer&) = delete;
+        TaskTracer& operator=(const TaskTracer&) = delete;
+        TaskTracer(TaskTracer&&) = delete;
+        TaskTracer& operator=(TaskTracer&&) = delete;
+        ~TaskTracer() = default;
+
+        // nanoseconds since the tracer was created
+        int64_t now() const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_epoch).count();
+        }
+
+        // `thread_id` names the calling thread's track (ThreadPool passes the worker index), the first call sets it
+        void record(const Event& event, const size_t thread_id)
+        {
+            local_ring(thread_id).push(event);
+        }
+
+        size_t dropped() const
+        {
+            std::lock_guard<std::mutex> guard(m_rings_lock);
+
+            size_t total = 0;
+            for (const auto& ring : m_rings)
+                total += ring->dropped();
+
+            return total;
+        }
+
+        /*
+         *  drains every ring and writes one complete trace document.
+         *  events recorded while flushing either make it into this document or the next one.
+         */
+        void flush(std::ostream& out)
+        {
+            std::lock_guard<std::mutex> guard(m_rings_lock);
+
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+            bool first = true;
+            auto separate = [&out, &first]()
+            {
+                if (!first)
+                    out << ',';
+                first = false;
+            };
+
+            for (const auto& ring : m_rings)
+            {
+                separate();
+                out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->thread_id()
+                    << ",\"args\":{\"name\":\"worker " << ring->thread_id() << "\"}}";
+
+                ring->drain(
+                    [&](const Event& event)
+                    {
+                        separate();
+                        out << "{\"name\":\"";
+                        write_escaped(out, event.label != nullptr ? event.label : "task");
+                        out << "\",\"cat\":\"task\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->thread_id()
+                            << ",\"ts\":";
+                        write_micros(out, event.start_ns);
+                        out << ",\"dur\":";
+                        write_micros(out, event.end_ns - event.start_ns);
+                        out << ",\"args\":{\"submit_us\":";
+                        write_micros(out, event.submit_ns);
+                        out << ",\"queued_us\":";
+                        write_micros(out, event.start_ns - event.submit_ns);
+                        out << "}}";
+                    });
+            }
+
+            out << "]}\n";
+        }
+
+        bool flush(const std::string& path)
+        {
+            std::ofstream out(path, std::ios::trunc);
+            if (!out)
+                return false;
+
+            flush(out);
+            return static_cast<bool>(out);
+        }
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_TASKTRACER_HPP
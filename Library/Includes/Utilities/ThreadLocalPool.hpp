@@ -0,0 +1,358 @@
+#ifndef _LIBRARY_UTILITIES_THREADLOCALPOOL_HPP
+#define _LIBRARY_UTILITIES_THREADLOCALPOOL_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Utilities
+{
+    /*
+     *  process-wide small object allocator with a heap per thread.
+     *
+     *  - requests up to `max_block_size` bytes are served from 64KB slabs. every slab
+     *    holds one power of two size class and belongs to the heap that carved it.
+     *  - allocate and same-thread deallocate touch only the calling thread's free lists.
+     *  - a block freed by another thread is parked in that thread's outgoing batch and
+     *    handed back to the owning heap with a single CAS every `remote_batch` blocks.
+     *    flush( ) hands over a partial batch early.
+     *  - a heap outlives its thread: on thread exit it is orphaned with its slabs and
+     *    adopted by the next new thread. slabs are never returned to the system.
+     *  - larger or over-aligned requests go straight to ::operator new.
+     */
+    class ThreadLocalPool
+    {
+    public:
+        static constexpr size_t slab_size = size_t{64} * 1024;
+        static constexpr size_t max_block_size = 1024;
+        static constexpr size_t remote_batch = 32;
+
+    private:
+        static constexpr size_t min_block_shift = 4;  // 16 byte blocks
+        static constexpr size_t size_classes = 7;     // 16 .. 1024 bytes
+        static constexpr size_t header_size = 64;
+
+        struct Block
+        {
+            Block* next;
+        };
+
+        struct Heap;
+
+        struct alignas(header_size) Slab
+        {
+            Heap* owner;
+            size_t size_class;
+        };
+
+        struct Heap
+        {
+            std::array<Block*, size_classes> free{};
+            std::array<std::byte*, size_classes> bump{};
+            std::array<std::byte*, size_classes> bump_end{};
+
+            // blocks other threads gave back
+            std::atomic<Block*> remote{nullptr};
+
+            // blocks this thread freed on behalf of `target`, not handed over yet
+            Heap* target = nullptr;
+            Block* batch_head = nullptr;
+            Block* batch_tail = nullptr;
+            size_t batch_count = 0;
+        };
+
+        struct Registry
+        {
+            std::mutex lock;
+            std::vector<Heap*> orphans;
+        };
+
+        // releases the heap when its thread exits
+        struct HeapOwner
+        {
+            HeapOwner()
+            {
+                t_heap = adopt();
+            }
+
+            HeapOwner(const HeapOwner&) = delete;
+            HeapOwner& operator=(const HeapOwner&) = delete;
+            HeapOwner(HeapOwner&&) = delete;
+            HeapOwner& operator=(HeapOwner&&) = delete;
+
+            ~HeapOwner()
+            {
+                auto* heap = t_heap;
+                flush_batch(*heap);
+
+                t_heap = nullptr;
+                t_exited = true;
+
+                auto& registry = get_registry();
+                std::lock_guard<std::mutex> guard(registry.lock);
+                registry.orphans.push_back(heap);
+            }
+        };
+
+        // trivially destructible, so they stay readable while other thread_locals are torn down
+        static inline thread_local Heap* t_heap = nullptr;
+        static inline thread_local bool t_exited = false;
+
+        static Registry& get_registry()
+        {
+            // leaked on purpose, threads may still free blocks after static destruction
+            static auto* registry = new Registry;
+            return *registry;
+        }
+
+        static Heap* adopt()
+        {
+            auto& registry = get_registry();
+            std::lock_guard<std::mutex> guard(registry.lock);
+
+            if (registry.orphans.empty())
+                return new Heap;
+
+            auto* heap = registry.orphans.back();
+            registry.orphans.pop_back();
+            return heap;
+        }
+
+        static Heap* local_heap()
+        {
+            if (t_heap != nullptr || t_exited)
+                return t_heap;
+
+            thread_local HeapOwner owner;
+            return t_heap;
+        }
+
+        static bool pooled(const size_t bytes, const size_t alignment)
+        {
+            return bytes <= max_block_size && alignment <= alignof(std::max_align_t);
+        }
+
+        static size_t class_of(const size_t bytes)
+        {
+            if (bytes <= (size_t{1} << min_block_shift))
+                return 0;
+
+            const size_t width = std::bit_width(bytes - 1);
+            return width - min_block_shift;
+        }
+
+        static Slab* slab_of(void* block)
+        {
+            return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(block) & ~(uintptr_t{slab_size} - 1));
+        }
+
+        static void push_remote(Heap& owner, Block* head, Block* tail)
+        {
+            tail->next = owner.remote.load(std::memory_order_relaxed);
+            while (!owner.remote.compare_exchange_weak(
+                tail->next, head, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        static void flush_batch(Heap& heap)
+        {
+            if (heap.batch_count == 0)
+                return;
+
+            push_remote(*heap.target, heap.batch_head, heap.batch_tail);
+
+            heap.target = nullptr;
+            heap.batch_head = heap.batch_tail = nullptr;
+            heap.batch_count = 0;
+        }
+
+        static void free_remote(Heap& heap, Heap& owner, Block* block)
+        {
+            if (heap.target != &owner)
+            {
+                flush_batch(heap);
+                heap.target = &owner;
+                heap.batch_tail = block;
+            }
+
+            block->next = heap.batch_head;
+            heap.batch_head = block;
+
+            if (++heap.batch_count == remote_batch)
+                flush_batch(heap);
+        }
+
+        static void* allocate_from(Heap& heap, const size_t size_class)
+        {
+            if (heap.free[size_class] == nullptr)
+            {
+                // take back whatever other threads returned, sorted into the class lists
+                for (auto* block = heap.remote.exchange(nullptr, std::memory_order_acquire); block != nullptr;)
+                {
+                    auto* next = block->next;
+                    auto& list = heap.free[slab_of(block)->size_class];
+                    block->next = list;
+                    list = block;
+                    block = next;
+                }
+            }
+
+            if (auto* block = heap.free[size_class]; block != nullptr)
+            {
+                heap.free[size_class] = block->next;
+                return block;
+            }
+
+            const auto block_size = size_t{1} << (size_class + min_block_shift);
+            if (static_cast<size_t>(heap.bump_end[size_class] - heap.bump[size_class]) < block_size)
+            {
+                auto* memory = static_cast<std::byte*>(::operator new(slab_size, std::align_val_t{slab_size}));
+                new (memory) Slab{&heap, size_class};
+
+                heap.bump[size_class] = memory + header_size;
+                heap.bump_end[size_class] = memory + slab_size;
+            }
+
+            auto* block = heap.bump[size_class];
+            heap.bump[size_class] += block_size;
+            return block;
+        }
+
+        class PoolResource final : public std::pmr::memory_resource
+        {
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                return ThreadLocalPool::allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* memory, size_t bytes, size_t alignment) override
+            {
+                ThreadLocalPool::deallocate(memory, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
+    public:
+        static void* allocate(const size_t bytes, const size_t alignment = alignof(std::max_align_t))
+        {
+            if (!pooled(bytes, alignment))
+                return ::operator new(bytes, std::align_val_t{alignment});
+
+            const auto size_class = class_of(bytes);
+            if (auto* heap = local_heap(); heap != nullptr)
+                return allocate_from(*heap, size_class);
+
+            // thread is past its own teardown, borrow an orphaned heap for this one call
+            auto& registry = get_registry();
+            std::lock_guard<std::mutex> guard(registry.lock);
+
+            if (registry.orphans.empty())
+                registry.orphans.push_back(new Heap);
+
+            return allocate_from(*registry.orphans.back(), size_class);
+        }
+
+        // bytes and alignment must match the allocate( ) call
+        static void deallocate(void* memory,
+                               const size_t bytes,
+                               const size_t alignment = alignof(std::max_align_t)) noexcept
+        {
+            if (!pooled(bytes, alignment))
+            {
+                ::operator delete(memory, std::align_val_t{alignment});
+                return;
+            }
+
+            auto* block = new (memory) Block{nullptr};
+            auto& owner = *slab_of(memory)->owner;
+
+            // a thread that only frees gets a heap too, so its frees are batched like everyone else's
+            Heap* heap = nullptr;
+            try
+            {
+                heap = local_heap();
+            }
+            catch (...)
+            {
+                // no memory for a heap, the block goes back on its own below
+            }
+
+            if (heap == &owner)
+            {
+                auto& list = heap->free[slab_of(memory)->size_class];
+                block->next = list;
+                list = block;
+            }
+            else if (heap != nullptr)
+            {
+                free_remote(*heap, owner, block);
+            }
+            else
+            {
+                push_remote(owner, block, block);
+            }
+        }
+
+        // hands blocks this thread freed for other threads back to them now
+        static void flush() noexcept
+        {
+            if (auto* heap = t_heap; heap != nullptr)
+                flush_batch(*heap);
+        }
+
+        // the pool as a std::pmr resource, e.g. for DataStructures::pmr containers
+        static std::pmr::memory_resource* resource() noexcept
+        {
+            static auto* resource = new PoolResource;
+            return resource;
+        }
+    };
+
+    // stateless allocator over ThreadLocalPool, all instances compare equal
+    template<typename T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        PoolAllocator() noexcept = default;
+
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(const size_t count)
+        {
+            if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+
+            return static_cast<T*>(ThreadLocalPool::allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* memory, const size_t count) noexcept
+        {
+            ThreadLocalPool::deallocate(memory, count * sizeof(T), alignof(T));
+        }
+
+        template<typename U>
+        friend bool operator==(const PoolAllocator&, const PoolAllocator<U>&) noexcept
+        {
+            return true;
+        }
+    };
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_THREADLOCALPOOL_HPP
@@ -1,10 +1,22 @@
 #ifndef _LIBRARY_UTILITIES_THREADPOOL_HPP
 #define _LIBRARY_UTILITIES_THREADPOOL_HPP
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <stdexcept>
+#include <system_error>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -12,38 +24,393 @@
 #include <utility>
 
 #include "Utilities/AsyncResult.hpp"
+#include "Utilities/CacheLine.hpp"
 #include "DataStructures/ConcurrentBlockQueue.hpp"
+#include "Utilities/CpuTopology.hpp"
 #include "Utilities/FunctionWrapper.hpp"
+#include "Utilities/TaskTracer.hpp"
+#include "Utilities/TimerWheel.hpp"
 
 namespace Utilities
 {
+    // workers drain higher classes first, see ThreadPoolOptions::starvation_threshold
+    enum class TaskPriority : unsigned char
+    {
+        High,
+        Normal,
+        Background,
+    };
+
+    enum class ShutdownPolicy : unsigned char
+    {
+        Discard,  // workers stop after their current task, queued tasks are dropped
+        Drain,    // workers stop once the queues are empty, join( ) waits for them
+    };
+
+    struct TaskOptions
+    {
+        TaskPriority priority = TaskPriority::Normal;
+        const char* label = nullptr;  // shown in traces, not copied (e.g. a string literal)
+    };
+
+    struct ThreadPoolOptions
+    {
+        size_t workers = 0;  // 0 = hardware_concurrency( ) + 1, the minimum in elastic mode
+
+        /*
+         *  elastic mode when greater than workers: a supervisor adds a worker while tasks wait
+         *  longer than scale_up_wait or more than scale_up_depth are queued (this also covers
+         *  workers stuck in long tasks), workers idle for idle_timeout retire. at most one
+         *  worker is added or retired per resize_cooldown.
+         */
+        size_t max_workers = 0;
+        std::chrono::microseconds scale_up_wait{std::chrono::milliseconds(1)};
+        size_t scale_up_depth = 64;
+        std::chrono::microseconds idle_timeout{std::chrono::seconds(1)};
+        std::chrono::microseconds resize_cooldown{std::chrono::milliseconds(5)};
+
+        // a lower class that hasn't been served for this long gets the next free worker
+        std::chrono::microseconds starvation_threshold{std::chrono::milliseconds(10)};
+
+        // tick of the timer wheel behind submit_after/at/every
+        std::chrono::microseconds timer_resolution{std::chrono::milliseconds(1)};
+
+        // worker i is pinned to cpu_sets[i % cpu_sets.size( )], empty = the OS places workers
+        std::vector<std::vector<unsigned>> cpu_sets{};
+
+        // without explicit cpu_sets, pin the workers to the first cpus in CpuTopology::placement( ) order
+        bool pin_to_topology = false;
+    };
 
     class ThreadPool
     {
+        struct Worker
+        {
+            std::jthread thread;
+            std::atomic<bool> retired{false};    // set by the worker right before it returns
+            std::atomic<bool> dismissed{false};  // set when the worker couldn't be pinned, it leaves at once
+        };
+
         using WaitableTask = Utilities::FunctionWrapper;
         using TaskQueue = DataStructures::ConcurrentBlockQueue<WaitableTask>;
-        using WorkerGroup = std::vector<std::jthread>;
+        using WorkerGroup = std::list<Worker>;
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t priority_levels = 3;
+
+        // declared first so that it outlives the workers recording into it
+        std::unique_ptr<TaskTracer> tracer_storage;
+        std::atomic<TaskTracer*> tracer{nullptr};
+        std::once_flag tracer_init;
+
+        const int64_t starvation_threshold_ns;
+        const std::chrono::microseconds timer_resolution;
 
-        TaskQueue tasks;
+        const size_t min_workers;
+        const size_t max_workers;
+        const int64_t scale_up_wait_ns;
+        const size_t scale_up_depth;
+        const int64_t idle_timeout_ns;
+        const int64_t resize_cooldown_ns;
+
+        /*
+         *  pinned workers are grouped by the L3 cache they share. each group gets its own
+         *  queues, workers serve their own group first and steal from the others after.
+         *  unpinned pools have a single domain.
+         */
+        struct Domain
+        {
+            // one FIFO per TaskPriority, indexed by its value
+            std::array<TaskQueue, priority_levels> tasks;
+
+            // written by every pop, kept off the queues' lines
+            alignas(cache_line_size) std::array<std::atomic<int64_t>, priority_levels> served_at{};  // steady clock ns
+        };
+
+        std::deque<Domain> domains;
+        // round robin for submissions from outside the pool, away from the read-mostly fields around it
+        alignas(cache_line_size) std::atomic<size_t> next_domain{0};
+
+        // lets tasks running on a worker submit into the worker's own domain
+        static inline thread_local const ThreadPool* current_pool = nullptr;
+        static inline thread_local size_t current_domain = 0;
+        static inline thread_local size_t current_worker = 0;  // index in spawn order, never reused
+
+        // worker i runs on cpu_sets[i % size] in domain cpu_set_domains[i % size]
+        std::vector<std::vector<unsigned>> cpu_sets;
+        std::vector<size_t> cpu_set_domains;
+
+        // guards the worker list, only taken when workers start, retire or get reaped
+        std::mutex workers_lock;
         WorkerGroup workers;
-        std::atomic_bool done{false};  // true = complete all remaining work & exit
+        size_t spawned = 0;
+        std::atomic<size_t> live_workers{0};
+        std::atomic<int64_t> resized_at{0};  // steady clock ns of the last added or retired worker
+        std::atomic_bool done{false};        // true = complete all remaining work & exit
+        std::atomic_bool draining{false};    // true = exit once no task is left
+
+        // elastic mode only, declared after the workers so it stops before they are joined
+        std::jthread supervisor;
+
+        // created on first use, declared last so its thread stops before the queues go away
+        std::unique_ptr<TimerWheel> timer_storage;
+        std::once_flag timer_init;
+
+        static int64_t clock_ns()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        }
+
+        static std::optional<WaitableTask> pop_from(Domain& domain, const size_t level, const int64_t now)
+        {
+            auto task = domain.tasks[level].try_pop();
+            if (task)
+                domain.served_at[level].store(now, std::memory_order_relaxed);
+
+            return task;
+        }
+
+        std::optional<WaitableTask> next_task(const size_t home)
+        {
+            const auto now = clock_ns();
+            auto& local = domains[home];
+
+            // aging: lowest class first, a class that waited past the threshold
+            // jumps ahead once and then has to wait for another threshold
+            for (auto level = priority_levels - 1; level > 0; --level)
+            {
+                if (!local.tasks[level].was_empty() &&
+                    now - local.served_at[level].load(std::memory_order_relaxed) > starvation_threshold_ns)
+                {
+                    if (auto task = pop_from(local, level, now))
+                        return task;
+                }
+            }
+
+            // priority beats locality: a high class task in another domain runs before local normal work
+            for (size_t level = 0; level < priority_levels; ++level)
+            {
+                for (size_t offset = 0; offset < domains.size(); ++offset)
+                {
+                    if (auto task = pop_from(domains[(home + offset) % domains.size()], level, now))
+                        return task;
+                }
+            }
+
+            return {};
+        }
+
+        void enqueue(const TaskPriority priority, WaitableTask&& task)
+        {
+            const auto level = static_cast<size_t>(priority);
+
+            size_t target = 0;
+            if (current_pool == this)
+                target = current_domain;
+            else if (domains.size() > 1)
+                target = next_domain.fetch_add(1, std::memory_order_relaxed) % domains.size();
+
+            auto& domain = domains[target];
+
+            // start the starvation clock when the class goes from idle to pending
+            if (domain.tasks[level].was_empty())
+                domain.served_at[level].store(clock_ns(), std::memory_order_relaxed);
+
+            domain.tasks[level].push(std::move(task));
+        }
+
+        void dispatch(const TaskOptions& options, WaitableTask&& task)
+        {
+            auto* active_tracer = tracer.load(std::memory_order_acquire);
+            if (active_tracer == nullptr)
+            {
+                enqueue(options.priority, std::move(task));
+                return;
+            }
+
+            enqueue(options.priority,
+                    WaitableTask{[active_tracer,
+                                  label = options.label,
+                                  submitted = active_tracer->now(),
+                                  task = std::move(task)]() mutable
+                                 {
+                                     const auto started = active_tracer->now();
+                                     task();
+                                     active_tracer->record({label, submitted, started, active_tracer->now()},
+                                                           current_worker);
+                                 }});
+        }
+
+        TimerWheel& timers()
+        {
+            std::call_once(timer_init,
+                           [this]()
+                           {
+                               timer_storage = std::make_unique<TimerWheel>(
+                                   [this](WaitableTask&& task) { dispatch(TaskOptions{}, std::move(task)); },
+                                   timer_resolution);
+                           });
+
+            return *timer_storage;
+        }
+
+        bool elastic() const
+        {
+            return max_workers > min_workers;
+        }
+
+        // caller holds workers_lock
+        void spawn_worker()
+        {
+            auto& worker = workers.emplace_back();
+            const auto slot = cpu_sets.empty() ? 0 : spawned % cpu_sets.size();
+            const auto domain = cpu_sets.empty() ? 0 : cpu_set_domains[slot];
+
+            try
+            {
+                worker.thread = std::jthread(&Utilities::ThreadPool::worker_method, this, &worker, spawned, domain);
+            }
+            catch (...)
+            {
+                workers.pop_back();
+                throw;
+            }
+
+            ++spawned;
+            live_workers.fetch_add(1, std::memory_order_relaxed);
+            resized_at.store(clock_ns(), std::memory_order_relaxed);
+
+            if (!cpu_sets.empty() && !pin_thread(worker.thread.native_handle(), cpu_sets[slot]))
+            {
+                // already running, it exits on its own and gets reaped like a retired worker
+                worker.dismissed.store(true, std::memory_order_relaxed);
+                live_workers.fetch_sub(1, std::memory_order_relaxed);
+                throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                        "ThreadPool: failed to pin worker");
+            }
+        }
+
+        // no retiring once a join( ) started, draining workers exit through the drain path
+        bool can_retire(const int64_t now) const
+        {
+            return !draining && !done && live_workers.load(std::memory_order_relaxed) > min_workers &&
+                   now - resized_at.load(std::memory_order_relaxed) >= resize_cooldown_ns;
+        }
 
-        void worker_method()
+        bool try_retire(const int64_t now)
         {
+            // idle workers poll this, only take the lock when retiring looks possible
+            if (!can_retire(now))
+                return false;
+
+            std::lock_guard<std::mutex> guard(workers_lock);
+            if (!can_retire(now))
+                return false;
+
+            live_workers.fetch_sub(1, std::memory_order_relaxed);
+            resized_at.store(now, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool needs_worker(const int64_t now) const
+        {
+            size_t depth = 0;
+            for (const auto& domain : domains)
+            {
+                for (size_t level = 0; level < priority_levels; ++level)
+                {
+                    const auto queued = domain.tasks[level].was_size();
+                    if (queued == 0)
+                        continue;
+
+                    // nothing got popped from a non-empty queue for a while: every worker is busy
+                    if (now - domain.served_at[level].load(std::memory_order_relaxed) > scale_up_wait_ns)
+                        return true;
+
+                    depth += queued;
+                }
+            }
+
+            return depth > scale_up_depth;
+        }
+
+        void supervise(const std::stop_token& stop)
+        {
+            std::mutex sleep_lock;
+            std::condition_variable_any sleeper;
+            const auto period = std::chrono::nanoseconds(resize_cooldown_ns);
+
             while (!done)
+            {
+                {
+                    std::unique_lock<std::mutex> guard(sleep_lock);
+                    if (sleeper.wait_for(guard, stop, period, []() { return false; }) || stop.stop_requested())
+                        return;
+                }
+
+                std::lock_guard<std::mutex> guard(workers_lock);
+                workers.remove_if([](const Worker& worker) { return worker.retired.load(); });
+
+                const auto now = clock_ns();
+                if (live_workers.load(std::memory_order_relaxed) < max_workers &&
+                    now - resized_at.load(std::memory_order_relaxed) >= resize_cooldown_ns && needs_worker(now))
+                {
+                    try
+                    {
+                        spawn_worker();
+                    }
+                    catch (...)
+                    {
+                        // no thread or no pinning for it, the pool keeps its current workers
+                    }
+                }
+            }
+        }
+
+        void worker_method(Worker* self, const size_t index, const size_t domain)
+        {
+            current_pool = this;
+            current_domain = domain;
+            current_worker = index;
+
+            auto idle_since = clock_ns();
+
+            while (!done && !self->dismissed.load(std::memory_order_relaxed))
             {
                 // wait_and_pop requires interruptible conditional variable
                 // to wake the threads up in case a join( ) request received
                 // when there are no tasks available
-                auto task = tasks.try_pop();
+                auto task = next_task(domain);
 
                 if (task)
+                {
                     (*task)();
+                    idle_since = clock_ns();
+                }
+                else if (draining)
+                {
+                    // a task still running elsewhere may queue more, its own worker picks that up
+                    break;
+                }
+                else if (elastic())
+                {
+                    const auto now = clock_ns();
+                    if (now - idle_since > idle_timeout_ns)
+                    {
+                        if (try_retire(now))
+                            break;
+
+                        // not allowed to retire yet, wait another idle timeout before asking again
+                        idle_since = now;
+                    }
+                }
 
                 // irrespective of availability of tasks,
                 // give a chance to other threads
                 std::this_thread::yield();
             }
+
+            self->retired.store(true);
         }
 
         static size_t compute_concurrency()
@@ -53,12 +420,72 @@ namespace Utilities
 
     public:
         ThreadPool(const size_t total_workers = compute_concurrency())
-            : done(false)
+            : ThreadPool(ThreadPoolOptions{.workers = total_workers})
+        {
+        }
+
+        explicit ThreadPool(const ThreadPoolOptions& options)
+            : starvation_threshold_ns(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(options.starvation_threshold).count())
+            , timer_resolution(options.timer_resolution)
+            , min_workers(options.workers == 0 ? compute_concurrency() : options.workers)
+            , max_workers(std::max(min_workers, options.max_workers))
+            , scale_up_wait_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(options.scale_up_wait).count())
+            , scale_up_depth(options.scale_up_depth)
+            , idle_timeout_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(options.idle_timeout).count())
+            , resize_cooldown_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(options.resize_cooldown).count())
+            , cpu_sets(options.cpu_sets)
+            , done(false)
         {
+            for (const auto& cpus : cpu_sets)
+                if (cpus.empty())
+                    throw std::invalid_argument("ThreadPool: empty cpu set in cpu_sets");
+
+            if (cpu_sets.empty() && options.pin_to_topology)
+            {
+                // one cpu per worker, so every L3 domain numbered below has a worker serving it.
+                // workers added in elastic mode wrap around onto these cpus
+                for (const auto cpu : CpuTopology::detect().placement())
+                {
+                    if (cpu_sets.size() == min_workers)
+                        break;
+                    cpu_sets.push_back({cpu});
+                }
+            }
+
+            if (!cpu_sets.empty())
+            {
+                // number the L3 domains the pinned workers actually use
+                const auto topology = CpuTopology::detect();
+                std::vector<size_t> dense_ids;
+
+                for (const auto& cpus : cpu_sets)
+                {
+                    const auto l3 = topology.l3_domain_of(cpus.front());
+
+                    auto known = std::find(dense_ids.begin(), dense_ids.end(), l3);
+                    if (known == dense_ids.end())
+                        known = dense_ids.insert(dense_ids.end(), l3);
+
+                    cpu_set_domains.push_back(static_cast<size_t>(known - dense_ids.begin()));
+                }
+
+                for (size_t i = 0; i < dense_ids.size(); ++i)
+                    domains.emplace_back();
+            }
+            else
+            {
+                domains.emplace_back();
+            }
+
             try
             {
-                for (auto i = 0u; i < total_workers; ++i)
-                    workers.emplace_back(std::jthread(&Utilities::ThreadPool::worker_method, this));
+                std::lock_guard<std::mutex> guard(workers_lock);
+                for (size_t i = 0; i < min_workers; ++i)
+                    spawn_worker();
+
+                if (elastic())
+                    supervisor = std::jthread([this](const std::stop_token& stop) { supervise(stop); });
             }
             catch (...)
             {
@@ -78,28 +505,133 @@ namespace Utilities
             join();
         }
 
-        void join()
+        /*
+         *  Drain blocks until every queued task ran, including tasks queued by those tasks.
+         *  tasks queued from outside the pool while draining and pending timers may be dropped.
+         *  must not be called from one of the pool's workers.
+         */
+        void join(const ShutdownPolicy policy = ShutdownPolicy::Discard)
         {
+            if (policy == ShutdownPolicy::Drain)
+            {
+                if (supervisor.joinable())
+                {
+                    supervisor.request_stop();
+                    supervisor.join();
+                }
+
+                draining = true;
+
+                // joined outside the lock, a worker may still be inside try_retire( )
+                WorkerGroup stopping;
+                {
+                    std::lock_guard<std::mutex> guard(workers_lock);
+                    stopping.splice(stopping.end(), workers);
+                }
+
+                for (auto& worker : stopping)
+                    if (worker.thread.joinable())
+                        worker.thread.join();
+                live_workers.store(0, std::memory_order_relaxed);
+            }
+
             done = true;
         }
 
+        // live workers, varies over time in elastic mode
         inline size_t size() const
         {
-            return workers.size();
+            return live_workers.load(std::memory_order_relaxed);
+        }
+
+        // queue sets, one per L3 cache domain used by pinned workers, 1 when unpinned
+        size_t cache_domains() const
+        {
+            return domains.size();
+        }
+
+        /*
+         *  records submit/start/end of every task submitted from here on, see TaskTracer.
+         *  repeated calls keep the first tracer.
+         */
+        void enable_tracing(const size_t events_per_thread = TaskTracer::default_capacity)
+        {
+            std::call_once(tracer_init,
+                           [this, events_per_thread]()
+                           {
+                               tracer_storage = std::make_unique<TaskTracer>(events_per_thread);
+                               tracer.store(tracer_storage.get(), std::memory_order_release);
+                           });
+        }
+
+        // nullptr until enable_tracing( ) is called
+        TaskTracer* task_tracer() const
+        {
+            return tracer.load(std::memory_order_acquire);
         }
 
         template<typename Fn, typename... Args>
+            requires(!std::same_as<std::remove_cvref_t<Fn>, TaskOptions>)
         auto submit(Fn callable, Args&&... args)
+        {
+            return submit(TaskOptions{}, std::move(callable), std::forward<Args>(args)...);
+        }
+
+        template<typename Fn, typename... Args>
+        auto submit(const TaskOptions& options, Fn callable, Args&&... args)
         {
             using return_t = std::invoke_result_t<Fn, Args...>;
             std::packaged_task<return_t()> task(std::bind(std::forward<Fn>(callable), std::forward<Args>(args)...));
 
             // caller waits on this future
             Utilities::AsyncResult<return_t> result{task.get_future()};
-            tasks.push(std::move(task));
+
+            dispatch(options, std::move(task));
 
             return result;
         }
+
+        // fire and forget, no future to carry an exception, so the callable must be noexcept
+        template<typename Fn>
+            requires(!std::same_as<std::remove_cvref_t<Fn>, TaskOptions>)
+        void post(Fn callable)
+        {
+            post(TaskOptions{}, std::move(callable));
+        }
+
+        template<typename Fn>
+        void post(const TaskOptions& options, Fn callable)
+        {
+            static_assert(std::is_nothrow_invocable_v<Fn&>, "ThreadPool: posted callables must be noexcept");
+            dispatch(options, WaitableTask{std::move(callable)});
+        }
+
+        /*
+         *  timers hand the callable to the pool once due, the wheel's single thread never
+         *  runs it. the returned handle cancels the timer, it must not outlive the pool.
+         *  like post( ) there is no future to carry an exception, so the callable must be
+         *  noexcept: a throw on a worker would terminate the process.
+         */
+        template<typename Fn>
+        TimerHandle submit_after(const std::chrono::steady_clock::duration delay, Fn callable)
+        {
+            static_assert(std::is_nothrow_invocable_v<Fn&>, "ThreadPool: timer callables must be noexcept");
+            return timers().schedule_after(delay, std::move(callable));
+        }
+
+        template<typename Fn>
+        TimerHandle submit_at(const std::chrono::steady_clock::time_point when, Fn callable)
+        {
+            static_assert(std::is_nothrow_invocable_v<Fn&>, "ThreadPool: timer callables must be noexcept");
+            return timers().schedule_at(when, std::move(callable));
+        }
+
+        template<typename Fn>
+        TimerHandle submit_every(const std::chrono::steady_clock::duration period, Fn callable)
+        {
+            static_assert(std::is_nothrow_invocable_v<Fn&>, "ThreadPool: timer callables must be noexcept");
+            return timers().schedule_every(period, std::move(callable));
+        }
     };
 }  // namespace Utilities
 
@@ -0,0 +1,417 @@
+#ifndef _LIBRARY_UTILITIES_TIMERWHEEL_HPP
+#define _LIBRARY_UTILITIES_TIMERWHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Utilities/FunctionWrapper.hpp"
+
+namespace Utilities
+{
+    class TimerWheel;
+
+    /*
+     *  identifies one scheduled timer. copies refer to the same timer.
+     *  must not be used after the wheel (or the pool owning it) is destroyed.
+     */
+    class TimerHandle
+    {
+        friend class TimerWheel;
+
+        TimerWheel* m_wheel = nullptr;
+        uint32_t m_index = 0;
+        uint32_t m_generation = 0;
+
+        TimerHandle(TimerWheel* wheel, uint32_t index, uint32_t generation)
+            : m_wheel(wheel)
+            , m_index(index)
+            , m_generation(generation)
+        {
+        }
+
+    public:
+        TimerHandle() = default;
+
+        // true if the timer was still pending, a periodic timer won't fire again
+        bool cancel();
+
+        bool valid() const
+        {
+            return m_wheel != nullptr;
+        }
+    };
+
+    /*
+     *  hierarchical timing wheel, 4 levels of 256 slots each.
+     *
+     *  - insert and cancel are O(1): timers live in a node pool and are linked into
+     *    intrusive slot lists by index.
+     *  - one timer thread advances the wheel every tick and hands expired callables
+     *    to the dispatcher, it never runs user code itself.
+     *  - timers never fire early, they fire on the first tick at or after their deadline.
+     *  - the thread sleeps without a deadline while no timer is pending.
+     */
+    class TimerWheel
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Dispatcher = std::function<void(FunctionWrapper&&)>;
+
+    private:
+        static constexpr uint32_t slot_bits = 8;
+        static constexpr uint32_t slots_per_level = 1u << slot_bits;
+        static constexpr uint32_t slot_mask = slots_per_level - 1;
+        static constexpr uint32_t levels = 4;
+        static constexpr uint64_t max_span = (uint64_t{1} << (slot_bits * levels)) - 1;  // in ticks
+        static constexpr uint32_t nil = UINT32_MAX;
+
+        // periodic timers share the callable across runs
+        struct Periodic
+        {
+            FunctionWrapper callable;
+            std::atomic<bool> running{false};  // a dispatched run hasn't returned yet
+
+            explicit Periodic(FunctionWrapper&& fn) noexcept
+                : callable(std::move(fn))
+            {
+            }
+        };
+
+        struct Node
+        {
+            std::optional<FunctionWrapper> once;
+            std::shared_ptr<Periodic> repeating;
+
+            uint64_t deadline = 0;  // in ticks
+            uint64_t period = 0;    // in ticks, 0 = one shot
+
+            uint32_t prev = nil;
+            uint32_t next = nil;
+            uint32_t list = nil;  // slot list the node is linked into, nil = free
+            uint32_t generation = 0;
+        };
+
+        const Clock::duration m_tick;
+        const Clock::time_point m_epoch;
+        const Dispatcher m_dispatch;
+
+        std::mutex m_lock;
+        std::condition_variable m_wakeup;
+        bool m_stopping = false;
+
+        std::vector<Node> m_nodes;
+        std::vector<uint32_t> m_free;
+        std::array<uint32_t, levels * slots_per_level> m_slots;
+        uint64_t m_current = 0;  // next tick to process
+        size_t m_pending = 0;
+
+        std::jthread m_thread;
+
+        uint64_t tick_of(const Clock::time_point when) const
+        {
+            // round up, a timer must never fire before its deadline
+            const auto since_epoch = when - m_epoch;
+            if (since_epoch <= Clock::duration::zero())
+                return 0;
+
+            return static_cast<uint64_t>((since_epoch + m_tick - Clock::duration(1)) / m_tick);
+        }
+
+        uint64_t elapsed_ticks(const Clock::time_point now) const
+        {
+            // round down, the current tick isn't over yet
+            return static_cast<uint64_t>((now - m_epoch) / m_tick);
+        }
+
+        uint64_t ticks_in(const Clock::duration period) const
+        {
+            const auto ticks = (period + m_tick - Clock::duration(1)) / m_tick;
+            return ticks > 0 ? static_cast<uint64_t>(ticks) : 1;
+        }
+
+        void link(const uint32_t index)
+        {
+            auto& node = m_nodes[index];
+
+            // past deadlines fire on the very next tick, far ones get parked in the
+            // top level and re-cascaded until they are within reach
+            const auto due = node.deadline < m_current ? m_current : node.deadline;
+            const auto delta = due - m_current > max_span ? max_span : due - m_current;
+            const auto expires = m_current + delta;
+
+            uint32_t level = 0;
+            while (level + 1 < levels && delta >= (uint64_t{1} << (slot_bits * (level + 1))))
+                ++level;
+
+            const auto slot = static_cast<uint32_t>((expires >> (slot_bits * level)) & slot_mask);
+            const auto list = level * slots_per_level + slot;
+
+            node.list = list;
+            node.prev = nil;
+            node.next = m_slots[list];
+            if (node.next != nil)
+                m_nodes[node.next].prev = index;
+            m_slots[list] = index;
+        }
+
+        void unlink(const uint32_t index)
+        {
+            auto& node = m_nodes[index];
+
+            if (node.prev != nil)
+                m_nodes[node.prev].next = node.next;
+            else
+                m_slots[node.list] = node.next;
+
+            if (node.next != nil)
+                m_nodes[node.next].prev = node.prev;
+
+            node.prev = node.next = node.list = nil;
+        }
+
+        void release(const uint32_t index)
+        {
+            auto& node = m_nodes[index];
+            node.once.reset();
+            node.repeating.reset();
+            ++node.generation;
+
+            m_free.push_back(index);
+            --m_pending;
+        }
+
+        uint32_t take_list(const uint32_t list)
+        {
+            const auto head = m_slots[list];
+            m_slots[list] = nil;
+            return head;
+        }
+
+        // re-distributes one upper level slot into the levels below it
+        void cascade(const uint32_t level)
+        {
+            const auto slot = static_cast<uint32_t>((m_current >> (slot_bits * level)) & slot_mask);
+
+            for (auto index = take_list(level * slots_per_level + slot); index != nil;)
+            {
+                const auto next = m_nodes[index].next;
+                link(index);
+                index = next;
+            }
+        }
+
+        void advance_to(const uint64_t now, std::vector<FunctionWrapper>& expired)
+        {
+            while (m_current <= now && m_pending > 0)
+            {
+                const auto slot = static_cast<uint32_t>(m_current & slot_mask);
+
+                for (uint32_t level = 1; level < levels; ++level)
+                {
+                    if (((m_current >> (slot_bits * (level - 1))) & slot_mask) != 0)
+                        break;
+                    cascade(level);
+                }
+
+                for (auto index = take_list(slot); index != nil;)
+                {
+                    auto& node = m_nodes[index];
+                    const auto next = node.next;
+                    node.prev = node.next = node.list = nil;
+
+                    if (node.deadline > m_current)
+                    {
+                        link(index);  // parked beyond the wheel span, not due yet
+                    }
+                    else if (node.period == 0)
+                    {
+                        expired.push_back(std::move(*node.once));
+                        release(index);
+                    }
+                    else
+                    {
+                        // a run still in progress takes this one's place, the callable never overlaps itself
+                        if (!node.repeating->running.exchange(true, std::memory_order_acquire))
+                            expired.emplace_back(
+                                [periodic = node.repeating]()
+                                {
+                                    periodic->callable();
+                                    periodic->running.store(false, std::memory_order_release);
+                                });
+
+                        // runs missed while the thread lagged behind are skipped, not bunched up
+                        node.deadline = std::max(node.deadline + node.period, m_current + 1);
+                        link(index);
+                    }
+
+                    index = next;
+                }
+
+                ++m_current;
+            }
+
+            // nothing pending, the next insert restarts the clock
+            if (m_pending == 0 && m_current <= now)
+                m_current = now + 1;
+        }
+
+        void run()
+        {
+            std::vector<FunctionWrapper> expired;
+            std::unique_lock<std::mutex> guard(m_lock);
+
+            while (!m_stopping)
+            {
+                if (m_pending == 0)
+                {
+                    m_wakeup.wait(guard, [this]() { return m_stopping || m_pending > 0; });
+                    continue;
+                }
+
+                m_wakeup.wait_until(guard, m_epoch + m_tick * static_cast<Clock::rep>(m_current));
+                if (m_stopping)
+                    break;
+
+                advance_to(elapsed_ticks(Clock::now()), expired);
+                if (expired.empty())
+                    continue;
+
+                // dispatch without holding the lock so inserts and cancels don't wait on the pool
+                guard.unlock();
+                for (auto& task : expired)
+                    m_dispatch(std::move(task));
+                expired.clear();
+                guard.lock();
+            }
+        }
+
+        TimerHandle schedule(const uint64_t deadline,
+                             const uint64_t period,
+                             std::optional<FunctionWrapper>&& once,
+                             std::shared_ptr<Periodic>&& repeating)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            uint32_t index = 0;
+            if (!m_free.empty())
+            {
+                index = m_free.back();
+                m_free.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(m_nodes.size());
+                m_nodes.emplace_back();
+            }
+
+            if (m_pending == 0)
+                m_current = elapsed_ticks(Clock::now());
+
+            auto& node = m_nodes[index];
+            node.once = std::move(once);
+            node.repeating = std::move(repeating);
+            node.deadline = deadline;
+            node.period = period;
+
+            link(index);
+
+            // the timer thread only sleeps without a deadline while nothing is pending
+            if (m_pending++ == 0)
+                m_wakeup.notify_one();
+
+            return {this, index, node.generation};
+        }
+
+    public:
+        explicit TimerWheel(Dispatcher dispatch, const Clock::duration tick = std::chrono::milliseconds(1))
+            : m_tick(tick > Clock::duration::zero() ? tick : Clock::duration(1))
+            , m_epoch(Clock::now())
+            , m_dispatch(std::move(dispatch))
+        {
+            m_slots.fill(nil);
+            m_thread = std::jthread(&Utilities::TimerWheel::run, this);
+        }
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+        TimerWheel(TimerWheel&&) = delete;
+        TimerWheel& operator=(TimerWheel&&) = delete;
+
+        // pending timers are dropped, callables already dispatched are unaffected
+        ~TimerWheel()
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_stopping = true;
+            }
+            m_wakeup.notify_one();
+        }
+
+        template<typename Fn>
+        TimerHandle schedule_at(const Clock::time_point when, Fn callable)
+        {
+            return schedule(tick_of(when), 0, FunctionWrapper{std::move(callable)}, nullptr);
+        }
+
+        template<typename Fn>
+        TimerHandle schedule_after(const Clock::duration delay, Fn callable)
+        {
+            return schedule_at(Clock::now() + delay, std::move(callable));
+        }
+
+        /*
+         *  fixed rate: the n-th run is due at now + n * period. a run that comes due while
+         *  the previous one is still running is skipped, so the callable never overlaps itself.
+         */
+        template<typename Fn>
+        TimerHandle schedule_every(const Clock::duration period, Fn callable)
+        {
+            return schedule(tick_of(Clock::now() + period),
+                            ticks_in(period),
+                            std::nullopt,
+                            std::make_shared<Periodic>(FunctionWrapper{std::move(callable)}));
+        }
+
+        bool cancel(const TimerHandle& handle)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            if (handle.m_index >= m_nodes.size())
+                return false;
+
+            const auto& node = m_nodes[handle.m_index];
+            if (node.generation != handle.m_generation || node.list == nil)
+                return false;
+
+            unlink(handle.m_index);
+            release(handle.m_index);
+
+            return true;
+        }
+
+        size_t pending()
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return m_pending;
+        }
+    };
+
+    inline bool TimerHandle::cancel()
+    {
+        return m_wheel != nullptr && m_wheel->cancel(*this);
+    }
+}  // namespace Utilities
+
+#endif  // !_LIBRARY_UTILITIES_TIMERWHEEL_HPP
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "DataStructures/Channel.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(ChannelTests, WhenClosedShouldDrainQueuedItemsThenReportEnd)
+{
+    DataStructures::Channel<std::string> channel;
+
+    EXPECT_TRUE(channel.send(std::string("first")));
+    EXPECT_TRUE(channel.send(std::string("second")));
+    channel.close();
+
+    EXPECT_FALSE(channel.send(std::string("late")));
+    EXPECT_EQ("first", channel.recv().value());
+    EXPECT_EQ("second", channel.recv().value());
+    EXPECT_FALSE(channel.recv().has_value());
+    EXPECT_FALSE(channel.recv_for(1ms).has_value());
+}
+
+TEST(ChannelTests, WhenBoundedAndFullShouldBlockProducerUntilReceived)
+{
+    DataStructures::Channel<int, 2> channel;
+
+    EXPECT_TRUE(channel.try_send(1));
+    EXPECT_TRUE(channel.try_send(2));
+    EXPECT_FALSE(channel.try_send(3));
+    EXPECT_FALSE(channel.send_for(3, 5ms));
+
+    std::atomic<bool> sent{false};
+    std::jthread producer(
+        [&channel, &sent]()
+        {
+            channel.send(3);
+            sent = true;
+        });
+
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(sent.load());
+
+    EXPECT_EQ(1, channel.recv().value());
+    producer.join();
+
+    EXPECT_TRUE(sent.load());
+    EXPECT_EQ(2, channel.try_recv().value());
+    EXPECT_EQ(3, channel.try_recv().value());
+}
+
+TEST(ChannelTests, WhenSelectingShouldWakeOnTheChannelThatGetsAnItem)
+{
+    DataStructures::Channel<int> numbers;
+    DataStructures::Channel<std::string> words;
+    std::optional<std::string> received;
+
+    std::jthread producer(
+        [&words]()
+        {
+            std::this_thread::sleep_for(10ms);
+            words.send(std::string("hello"));
+        });
+
+    const auto fired = DataStructures::select(
+        DataStructures::on_recv(numbers, [](std::optional<int>) { FAIL(); }),
+        DataStructures::on_recv(words, [&received](std::optional<std::string> word) { received = std::move(word); }));
+
+    EXPECT_EQ(1u, fired);
+    EXPECT_EQ("hello", received.value());
+
+    const auto timed_out =
+        DataStructures::select_for(5ms, DataStructures::on_recv(numbers, [](std::optional<int>) { FAIL(); }));
+    EXPECT_FALSE(timed_out.has_value());
+
+    numbers.close();
+    bool saw_close = false;
+    DataStructures::select(
+        DataStructures::on_recv(numbers, [&saw_close](std::optional<int> value) { saw_close = !value.has_value(); }));
+    EXPECT_TRUE(saw_close);
+}
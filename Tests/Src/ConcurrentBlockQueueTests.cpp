@@ -4,6 +4,8 @@
 #include <optional>
 
 #include "DataStructures/ConcurrentBlockQueue.hpp"
+#include "Utilities/ShardedCounter.hpp"
+#include "Utilities/ThreadLocalPool.hpp"
 
 TEST(ConcurrentBlockQueueTests, WhenCreatedShouldBeEmpty)
 {
@@ -65,3 +67,51 @@ TEST(ConcurrentBlockQueueTests, WhenClearModeEnabledShouldRejectPushAndUnblockWa
     EXPECT_FALSE(value.has_value());
     EXPECT_TRUE(queue.was_empty());
 }
+
+TEST(ConcurrentBlockQueueTests, WhenPooledBlocksFreedByConsumerThreadShouldKeepValues)
+{
+    DataStructures::ConcurrentBlockQueue<std::string, 4, Utilities::PoolAllocator<std::string>> queue;
+    constexpr int total = 10000;
+
+    auto consumer = std::async(
+        std::launch::async,
+        [&queue]()
+        {
+            int matched = 0;
+            for (int i = 0; i < total; ++i)
+                matched += queue.wait_and_pop().value() == std::to_string(i) ? 1 : 0;
+
+            Utilities::ThreadLocalPool::flush();
+            return matched;
+        });
+
+    for (int i = 0; i < total; ++i)
+        queue.push(std::to_string(i));
+
+    EXPECT_EQ(total, consumer.get());
+    EXPECT_TRUE(queue.was_empty());
+}
+
+TEST(ConcurrentBlockQueueTests, WhenSizeCountedByShardedCounterShouldTrackPushesAndPops)
+{
+    DataStructures::ConcurrentBlockQueue<int, 4, std::allocator<int>, Utilities::ShardedCounter> queue;
+    constexpr int per_producer = 5000;
+
+    auto produce = [&queue]()
+    {
+        for (int i = 0; i < per_producer; ++i)
+            queue.push(int{i});
+    };
+    auto first = std::async(std::launch::async, produce);
+    auto second = std::async(std::launch::async, produce);
+    first.get();
+    second.get();
+
+    EXPECT_EQ(2U * per_producer, queue.was_size());
+
+    for (int i = 0; i < per_producer; ++i)
+        EXPECT_TRUE(queue.try_pop().has_value());
+
+    EXPECT_EQ(static_cast<size_t>(per_producer), queue.was_size());
+    EXPECT_FALSE(queue.was_empty());
+}
@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
 #include <string>
+#include <thread>
+#include <vector>
 #include <optional>
 
 #include "DataStructures/ConcurrentHashMap.hpp"
+#include "Utilities/ShardedCounter.hpp"
 
 TEST(ConcurrentHashMapTests, WhenValueInsertedShouldBeReadableAndRemovable)
 {
@@ -20,3 +26,48 @@ TEST(ConcurrentHashMapTests, WhenValueInsertedShouldBeReadableAndRemovable)
     EXPECT_EQ("value", removed.value());
     EXPECT_TRUE(map.was_empty());
 }
+
+TEST(ConcurrentHashMapTests, WhenBuiltOnArenaShouldAllocateFromIt)
+{
+    std::array<std::byte, 64 * 1024> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    {
+        DataStructures::pmr::ConcurrentHashMap<int, int, std::hash<int>, 31> map(&arena);
+        for (int i = 0; i < 100; ++i)
+            map.insert(int{i}, i * 2);
+
+        EXPECT_EQ(100U, map.was_size());
+        EXPECT_EQ(84, map.get(42).value());
+    }
+
+    // nodes came out of the buffer, the null upstream throws on anything beyond it
+    auto* next_free = static_cast<std::byte*>(arena.allocate(1));
+    EXPECT_GT(next_free - buffer.data(), 100 * static_cast<std::ptrdiff_t>(sizeof(std::pair<const int, int>)));
+}
+
+TEST(ConcurrentHashMapTests, WhenShardedSizeCounterUsedShouldCountDistinctKeys)
+{
+    DataStructures::ConcurrentHashMap<int,
+                                      int,
+                                      std::hash<int>,
+                                      1031,
+                                      std::allocator<std::pair<const int, int>>,
+                                      Utilities::ShardedCounter>
+        map;
+    {
+        std::vector<std::jthread> writers;
+        for (int t = 0; t < 4; ++t)
+            writers.emplace_back(
+                [&map, t]()
+                {
+                    for (int i = 0; i < 1000; ++i)
+                        map.insert(t * 1000 + i, int{i});
+                    map.insert(t * 1000, 0);  // duplicate, not counted
+                });
+    }
+
+    EXPECT_EQ(4000U, map.was_size());
+    EXPECT_TRUE(map.remove(0).has_value());
+    EXPECT_EQ(3999U, map.was_size());
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Utilities/CpuTopology.hpp"
+
+namespace
+{
+    void write_file(const std::filesystem::path& path, const std::string& content)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path) << content << '\n';
+    }
+
+    /*
+     *  2 cores x 2 SMT threads per L3, 2 L3 domains:
+     *  core 0 = cpu 0/4, core 1 = cpu 1/5 share one L3, core 2 = cpu 2/6, core 3 = cpu 3/7 the other.
+     */
+    std::filesystem::path make_fake_sysfs()
+    {
+        const auto root = std::filesystem::temp_directory_path() / "threading_library_fake_cpu";
+        std::filesystem::remove_all(root);
+
+        write_file(root / "online", "0-7");
+        for (unsigned cpu = 0; cpu < 8; ++cpu)
+        {
+            const auto cpu_root = root / ("cpu" + std::to_string(cpu));
+            write_file(cpu_root / "topology" / "physical_package_id", "0");
+            write_file(cpu_root / "topology" / "core_id", std::to_string(cpu % 4));
+            write_file(cpu_root / "cache" / "index0" / "level", "1");
+            write_file(cpu_root / "cache" / "index0" / "shared_cpu_list", std::to_string(cpu));
+            write_file(cpu_root / "cache" / "index1" / "level", "3");
+            write_file(cpu_root / "cache" / "index1" / "shared_cpu_list", cpu % 4 < 2 ? "0-1,4-5" : "2-3,6-7");
+        }
+
+        return root;
+    }
+}  // namespace
+
+TEST(CpuTopologyTests, WhenCpuListParsedShouldExpandRanges)
+{
+    EXPECT_EQ((std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11}), Utilities::CpuTopology::parse_cpu_list("0-3,8,10-11"));
+    EXPECT_TRUE(Utilities::CpuTopology::parse_cpu_list("garbage").empty());
+}
+
+TEST(CpuTopologyTests, WhenSysfsDescribesTwoL3DomainsShouldPlaceCoresBeforeSiblings)
+{
+    const auto root = make_fake_sysfs();
+    const auto topology = Utilities::CpuTopology::detect(root.string(), false);
+    std::filesystem::remove_all(root);
+
+    ASSERT_EQ(8U, topology.cpus().size());
+    EXPECT_EQ(2U, topology.l3_domains());
+    EXPECT_EQ(topology.l3_domain_of(0), topology.l3_domain_of(5));
+    EXPECT_NE(topology.l3_domain_of(0), topology.l3_domain_of(2));
+    EXPECT_EQ((std::vector<unsigned>{0, 1, 4, 5, 2, 3, 6, 7}), topology.placement());
+}
+
+TEST(CpuTopologyTests, WhenPinnedToAllowedCpuShouldSucceed)
+{
+    const auto topology = Utilities::CpuTopology::detect();
+    ASSERT_FALSE(topology.cpus().empty());
+
+    std::promise<void> release;
+    std::jthread worker([parked = release.get_future()]() noexcept { parked.wait(); });
+
+    EXPECT_TRUE(Utilities::pin_thread(worker.native_handle(), {topology.placement().front()}));
+    release.set_value();
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "Utilities/Pipeline.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+TEST(PipelineTests, WhenStagesMixModesShouldKeepOrderAndBoundTokensInFlight)
+{
+    Utilities::ThreadPool pool(4);
+    constexpr int items = 1000;
+    constexpr size_t tokens = 4;
+
+    int next = 0;
+    std::atomic<int> in_flight{0};
+    std::atomic<int> peak{0};
+    int out_of_order_seen = 0;
+    std::vector<int> received;
+
+    auto pipeline = Utilities::make_pipeline(tokens,
+                                             [&]() -> std::optional<int>
+                                             {
+                                                 if (next == items)
+                                                     return {};
+
+                                                 const auto now = ++in_flight;
+                                                 peak = std::max(peak.load(), now);
+                                                 return next++;
+                                             })
+                        .then(Utilities::StageMode::Parallel, [](int value) { return int64_t{value} * value; })
+                        .then(Utilities::StageMode::SerialOutOfOrder,
+                              [&out_of_order_seen](int64_t value)
+                              {
+                                  ++out_of_order_seen;
+                                  return value;
+                              })
+                        .sink(Utilities::StageMode::SerialInOrder,
+                              [&](int64_t value)
+                              {
+                                  received.push_back(static_cast<int>(value % 1000003));
+                                  --in_flight;
+                              });
+
+    pipeline.run(pool);
+
+    ASSERT_EQ(static_cast<size_t>(items), received.size());
+    for (int i = 0; i < items; ++i)
+        EXPECT_EQ(static_cast<int>(int64_t{i} * i % 1000003), received[static_cast<size_t>(i)]);
+
+    EXPECT_EQ(items, out_of_order_seen);
+    EXPECT_LE(peak.load(), static_cast<int>(tokens));
+    EXPECT_EQ(4u, pipeline.stages());
+}
+
+TEST(PipelineTests, WhenItemsAreMoveOnlyAndLargeShouldMoveThemThrough)
+{
+    Utilities::ThreadPool pool(2);
+    int next = 0;
+    int64_t total = 0;
+
+    auto pipeline =
+        Utilities::make_pipeline(3,
+                                 [&next]() -> std::optional<std::unique_ptr<int>>
+                                 {
+                                     if (next == 100)
+                                         return {};
+                                     return std::make_unique<int>(next++);
+                                 })
+            .then(Utilities::StageMode::Parallel,
+                  [](std::unique_ptr<int> value)
+                  {
+                      std::array<int64_t, 16> wide{};  // too big for the inline slot
+                      wide.fill(*value);
+                      return wide;
+                  })
+            .sink(Utilities::StageMode::SerialOutOfOrder,
+                  [&total](std::array<int64_t, 16> wide) { total += wide.front() + wide.back(); });
+
+    pipeline.run(pool);
+    EXPECT_EQ(2 * (99 * 100 / 2), total);
+}
+
+TEST(PipelineTests, WhenStageThrowsShouldStopSourceRethrowAndRunAgain)
+{
+    Utilities::ThreadPool pool(2);
+    int next = 0;
+    int limit = 50;
+    bool armed = true;
+    std::vector<int> received;
+
+    auto pipeline = Utilities::make_pipeline(4,
+                                             [&]() -> std::optional<int>
+                                             {
+                                                 if (next == limit)
+                                                     return {};
+                                                 return next++;
+                                             })
+                        .then(Utilities::StageMode::SerialInOrder,
+                              [&armed](int value)
+                              {
+                                  if (armed && value == 10)
+                                      throw std::runtime_error("bad record");
+                                  return value;
+                              })
+                        .sink(Utilities::StageMode::SerialInOrder,
+                              [&received](int value) { received.push_back(value); });
+
+    EXPECT_THROW(pipeline.run(pool), std::runtime_error);
+    EXPECT_LT(next, limit);
+
+    // items before the failing one still reach the sink, later ones are dropped
+    ASSERT_EQ(10u, received.size());
+    EXPECT_EQ(9, received.back());
+
+    armed = false;
+    received.clear();
+    pipeline.run(pool);
+
+    ASSERT_FALSE(received.empty());
+    EXPECT_EQ(limit - 1, received.back());
+    EXPECT_TRUE(std::is_sorted(received.begin(), received.end()));
+}
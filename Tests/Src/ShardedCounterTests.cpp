@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "Utilities/ShardedCounter.hpp"
+
+TEST(ShardedCounterTests, WhenUpdatedConcurrentlyShouldSumAfterJoin)
+{
+    Utilities::ShardedCounter counter(4);
+    EXPECT_EQ(4U, counter.shards());
+
+    constexpr int threads = 8;
+    constexpr int per_thread = 10000;
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back(
+                [&counter]() noexcept
+                {
+                    for (int i = 0; i < per_thread; ++i)
+                        counter.increment();
+                    counter.add(-10);
+                });
+    }
+
+    EXPECT_EQ(int64_t{threads} * (per_thread - 10), counter.load());
+}
+
+TEST(ShardedCounterTests, WhenSamplesRecordedShouldMergeMinMaxSum)
+{
+    Utilities::ShardedAccumulator<int64_t> latencies;
+    {
+        std::vector<std::jthread> workers;
+        for (int64_t t = 0; t < 4; ++t)
+            workers.emplace_back(
+                [&latencies, t]() noexcept
+                {
+                    for (int64_t i = 1; i <= 100; ++i)
+                        latencies.record(t * 100 + i);
+                });
+    }
+
+    const auto summary = latencies.summary();
+    EXPECT_EQ(400U, summary.count);
+    EXPECT_EQ(400 * 401 / 2, summary.sum);
+    EXPECT_EQ(1, summary.min);
+    EXPECT_EQ(400, summary.max);
+    EXPECT_DOUBLE_EQ(200.5, summary.mean());
+
+    latencies.reset();
+    EXPECT_EQ(0U, latencies.summary().count);
+}
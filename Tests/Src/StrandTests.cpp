@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "Utilities/Strand.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+TEST(StrandTests, WhenPostedFromOneThreadShouldRunInFifoOrder)
+{
+    Utilities::ThreadPool pool(4);
+    Utilities::Strand strand(pool);
+    std::vector<int> order;
+    std::promise<void> finished;
+
+    constexpr int total = 1000;
+    for (int i = 0; i < total; ++i)
+        strand.post([&order, i]() { order.push_back(i); });
+    strand.post([&finished]() { finished.set_value(); });
+
+    // the strand goes out of scope right after this, its destructor waits for the drain to let go
+    finished.get_future().wait();
+
+    ASSERT_EQ(static_cast<size_t>(total), order.size());
+    for (int i = 0; i < total; ++i)
+        EXPECT_EQ(i, order[static_cast<size_t>(i)]);
+}
+
+TEST(StrandTests, WhenPostedConcurrentlyShouldNeverRunTwoCallablesAtOnce)
+{
+    Utilities::ThreadPool pool(4);
+    Utilities::Strand strand(pool);
+    std::atomic<int> running{0};
+    std::atomic<int> overlaps{0};
+    std::atomic<int> completed{0};
+    int unguarded = 0;  // only safe because the strand serializes access
+
+    constexpr int producers = 4;
+    constexpr int per_producer = 2000;
+    {
+        std::vector<std::jthread> threads;
+        for (int p = 0; p < producers; ++p)
+            threads.emplace_back(
+                [&]()
+                {
+                    for (int i = 0; i < per_producer; ++i)
+                        strand.post(
+                            [&]()
+                            {
+                                if (running.fetch_add(1) != 0)
+                                    ++overlaps;
+                                ++unguarded;
+                                running.fetch_sub(1);
+                                ++completed;
+                            });
+                });
+    }
+
+    while (completed.load() < producers * per_producer || !strand.idle())
+        std::this_thread::yield();
+
+    EXPECT_EQ(0, overlaps.load());
+    EXPECT_EQ(producers * per_producer, unguarded);
+}
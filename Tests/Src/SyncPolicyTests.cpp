@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "DataStructures/ConcurrentBlockQueue.hpp"
+#include "DataStructures/ConcurrentStack.hpp"
+#include "DataStructures/SynchronizedQueue.hpp"
+#include "Utilities/Event.hpp"
+#include "Utilities/Mutex.hpp"
+#include "Utilities/Semaphore.hpp"
+#include "Utilities/SyncPolicy.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(SyncPolicyTests, WhenMutexContendedShouldKeepIncrementsExclusive)
+{
+    Utilities::Mutex mutex;
+    int64_t counter = 0;
+
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back(
+                [&mutex, &counter]() noexcept
+                {
+                    for (int i = 0; i < 10000; ++i)
+                    {
+                        std::lock_guard<Utilities::Mutex> guard(mutex);
+                        ++counter;
+                    }
+                });
+    }
+
+    EXPECT_EQ(40000, counter);
+    EXPECT_TRUE(mutex.try_lock());
+    EXPECT_FALSE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(SyncPolicyTests, WhenEventNotifiedShouldWakeWaiterOnceStateChanged)
+{
+    Utilities::Mutex mutex;
+    Utilities::Event event;
+    bool ready = false;
+
+    // no waiter yet, nothing to wake
+    event.notify_one();
+
+    std::jthread notifier(
+        [&]() noexcept
+        {
+            std::this_thread::sleep_for(10ms);
+            {
+                std::lock_guard<Utilities::Mutex> guard(mutex);
+                ready = true;
+            }
+            event.notify_one();
+        });
+
+    std::unique_lock<Utilities::Mutex> guard(mutex);
+    event.wait(guard, [&ready]() { return ready; });
+    EXPECT_TRUE(ready);
+}
+
+TEST(SyncPolicyTests, WhenSemaphoreReleasedShouldHandOutExactlyTheCount)
+{
+    Utilities::Semaphore semaphore(1);
+
+    EXPECT_TRUE(semaphore.try_acquire());
+    EXPECT_FALSE(semaphore.try_acquire());
+
+    std::atomic<int> acquired{0};
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 3; ++t)
+            threads.emplace_back(
+                [&semaphore, &acquired]() noexcept
+                {
+                    semaphore.acquire();
+                    ++acquired;
+                });
+
+        std::this_thread::sleep_for(10ms);
+        EXPECT_EQ(0, acquired.load());
+        semaphore.release(3);
+    }
+
+    EXPECT_EQ(3, acquired.load());
+    EXPECT_FALSE(semaphore.try_acquire());
+}
+
+TEST(SyncPolicyTests, WhenContainersUseAdaptivePolicyShouldDeliverEveryItem)
+{
+    using Policy = Utilities::AdaptiveSyncPolicy;
+    DataStructures::ConcurrentBlockQueue<int, 4, std::allocator<int>, Utilities::AtomicCounter, Policy> block_queue;
+    DataStructures::SynchronizedQueue<int, std::allocator<int>, Policy> queue;
+    DataStructures::ConcurrentStack<int, 0, std::allocator<int>, Policy> stack;
+
+    constexpr int items = 1000;
+    std::jthread producer(
+        [&]()
+        {
+            for (int i = 0; i < items; ++i)
+            {
+                block_queue.push(int{i});
+                queue.push(i);
+                stack.push(i);
+            }
+        });
+
+    int64_t block_sum = 0;
+    int64_t queue_sum = 0;
+    int64_t stack_sum = 0;
+    for (int i = 0; i < items; ++i)
+    {
+        block_sum += block_queue.wait_and_pop().value();
+        queue_sum += queue.wait_and_pop();
+        stack_sum += stack.wait_and_pop();
+    }
+
+    constexpr int64_t expected = int64_t{items} * (items - 1) / 2;
+    EXPECT_EQ(expected, block_sum);
+    EXPECT_EQ(expected, queue_sum);
+    EXPECT_EQ(expected, stack_sum);
+
+    block_queue.enable_clear_mode();
+    EXPECT_FALSE(block_queue.wait_and_pop().has_value());
+}
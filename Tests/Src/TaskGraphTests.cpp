@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "Utilities/TaskGraph.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+TEST(TaskGraphTests, WhenRunRepeatedlyShouldRespectDependenciesEveryTime)
+{
+    Utilities::ThreadPool pool(4);
+    Utilities::TaskGraph graph;
+    std::atomic<int> clock{0};
+    int stamp[4] = {};
+
+    // diamond: 0 -> {1, 2} -> 3
+    const auto source = graph.emplace([&]() { stamp[0] = ++clock; });
+    const auto left = graph.emplace([&]() { stamp[1] = ++clock; });
+    const auto right = graph.emplace([&]() { stamp[2] = ++clock; });
+    const auto sink = graph.emplace([&]() { stamp[3] = ++clock; });
+    graph.precede(source, left);
+    graph.precede(source, right);
+    graph.precede(left, sink);
+    graph.precede(right, sink);
+
+    for (int run = 0; run < 3; ++run)
+    {
+        graph.run(pool);
+
+        EXPECT_EQ(4 * (run + 1), clock.load());
+        EXPECT_LT(stamp[0], stamp[1]);
+        EXPECT_LT(stamp[0], stamp[2]);
+        EXPECT_LT(stamp[1], stamp[3]);
+        EXPECT_LT(stamp[2], stamp[3]);
+    }
+}
+
+TEST(TaskGraphTests, WhenNodeThrowsShouldCancelDependentsAndRethrow)
+{
+    Utilities::ThreadPool pool(2);
+    Utilities::TaskGraph graph;
+    std::atomic<bool> dependent_ran{false};
+    std::atomic<bool> independent_ran{false};
+
+    const auto failing = graph.emplace([]() { throw std::runtime_error("boom"); });
+    const auto child = graph.emplace([]() {});
+    const auto grandchild = graph.emplace([&dependent_ran]() { dependent_ran = true; });
+    graph.emplace([&independent_ran]() { independent_ran = true; });
+    graph.precede(failing, child);
+    graph.precede(child, grandchild);
+
+    EXPECT_THROW(graph.run(pool), std::runtime_error);
+    EXPECT_FALSE(dependent_ran.load());
+    EXPECT_TRUE(independent_ran.load());
+}
+
+TEST(TaskGraphTests, WhenSubgraphSplicedShouldRunBetweenItsBarriers)
+{
+    Utilities::ThreadPool pool(4);
+    std::atomic<int> clock{0};
+    int before = 0;
+    int inner_first = 0;
+    int inner_second = 0;
+    int after = 0;
+
+    Utilities::TaskGraph inner;
+    const auto first = inner.emplace([&]() { inner_first = ++clock; });
+    const auto second = inner.emplace([&]() { inner_second = ++clock; });
+    inner.precede(first, second);
+
+    Utilities::TaskGraph outer;
+    const auto start = outer.emplace([&]() { before = ++clock; });
+    const auto finish = outer.emplace([&]() { after = ++clock; });
+    const auto spliced = outer.splice(std::move(inner));
+    outer.precede(start, spliced.entry);
+    outer.precede(spliced.exit, finish);
+
+    EXPECT_EQ(0U, inner.size());
+    outer.run(pool);
+
+    EXPECT_EQ(1, before);
+    EXPECT_EQ(2, inner_first);
+    EXPECT_EQ(3, inner_second);
+    EXPECT_EQ(4, after);
+}
+
+TEST(TaskGraphTests, WhenEmptySubgraphSplicedShouldKeepExitAfterEntry)
+{
+    Utilities::ThreadPool pool(4);
+    std::atomic<int> clock{0};
+    int before = 0;
+    int after = 0;
+
+    Utilities::TaskGraph outer;
+    const auto start = outer.emplace(
+        [&]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            before = ++clock;
+        });
+    const auto finish = outer.emplace([&]() { after = ++clock; });
+    const auto spliced = outer.splice(Utilities::TaskGraph{});
+    outer.precede(start, spliced.entry);
+    outer.precede(spliced.exit, finish);
+
+    outer.run(pool);
+
+    EXPECT_EQ(1, before);
+    EXPECT_EQ(2, after);
+}
+
+TEST(TaskGraphTests, WhenGraphHasCycleShouldRejectRun)
+{
+    Utilities::ThreadPool pool(1);
+    Utilities::TaskGraph graph;
+
+    const auto a = graph.emplace([]() {});
+    const auto b = graph.emplace([]() {});
+    graph.precede(a, b);
+    graph.precede(b, a);
+
+    EXPECT_THROW(graph.run(pool), std::logic_error);
+    EXPECT_THROW(graph.precede(a, 7), std::out_of_range);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+
+#include "Utilities/TaskGroup.hpp"
+#include "Utilities/ThreadPool.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(TaskGroupTests, WhenPoolBusyShouldRunGroupTasksOnWaitingThread)
+{
+    Utilities::ThreadPool pool(1);
+    std::promise<void> release;
+    pool.post([blocker = release.get_future().share()]() noexcept { blocker.wait(); });
+
+    Utilities::TaskGroup group(pool);
+    std::atomic<int> on_caller{0};
+    const auto caller = std::this_thread::get_id();
+
+    for (int i = 0; i < 10; ++i)
+        group.run(
+            [&on_caller, caller]() noexcept
+            {
+                if (std::this_thread::get_id() == caller)
+                    ++on_caller;
+            });
+
+    // the only worker is blocked, so waiting must not depend on it
+    group.wait();
+    EXPECT_EQ(10, on_caller.load());
+
+    release.set_value();
+}
+
+TEST(TaskGroupTests, WhenTaskThrowsShouldCancelSiblingsAndRethrow)
+{
+    Utilities::ThreadPool pool(2);
+    Utilities::TaskGroup group(pool);
+    std::atomic<bool> started{false};
+    std::atomic<bool> observed_stop{false};
+
+    group.run(
+        [&started, &observed_stop](const std::stop_token& token)
+        {
+            started = true;
+            while (!token.stop_requested())
+                std::this_thread::sleep_for(1ms);
+            observed_stop = true;
+        });
+    group.run(
+        [&started]()
+        {
+            while (!started)
+                std::this_thread::yield();
+            throw std::runtime_error("failed");
+        });
+
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_TRUE(observed_stop.load());
+    EXPECT_TRUE(group.cancelled());
+
+    // cancelled groups skip what is queued later, and the exception is only reported once
+    std::atomic<bool> ran{false};
+    group.run([&ran]() noexcept { ran = true; });
+    EXPECT_NO_THROW(group.wait());
+    EXPECT_FALSE(ran.load());
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "Utilities/TaskTracer.hpp"
+
+TEST(TaskTracerTests, WhenEventsRecordedShouldFlushChromeTraceEvents)
+{
+    Utilities::TaskTracer tracer;
+
+    tracer.record({"parse \"request\"", 1000, 2500, 4000}, 0);
+    std::jthread([&tracer]() { tracer.record({nullptr, 0, 10, 20}, 7); }).join();
+
+    std::ostringstream out;
+    tracer.flush(out);
+    const auto trace = out.str();
+
+    EXPECT_EQ(0U, trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"parse \\\"request\\\"\""));
+    EXPECT_NE(std::string::npos, trace.find("\"ts\":2.500,\"dur\":1.500"));
+    EXPECT_NE(std::string::npos, trace.find("\"queued_us\":1.500"));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"task\""));
+    EXPECT_NE(std::string::npos, trace.find("\"tid\":7"));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"worker 7\""));
+}
+
+TEST(TaskTracerTests, WhenRingFullShouldDropNewEventsUntilFlushed)
+{
+    Utilities::TaskTracer tracer(2);
+
+    for (int i = 0; i < 5; ++i)
+        tracer.record({"task", 0, i, i + 1}, 0);
+
+    EXPECT_EQ(3U, tracer.dropped());
+
+    std::ostringstream first;
+    tracer.flush(first);
+    std::ostringstream second;
+    tracer.flush(second);
+
+    EXPECT_NE(std::string::npos, first.str().find("\"ph\":\"X\""));
+    EXPECT_EQ(std::string::npos, second.str().find("\"ph\":\"X\""));
+}
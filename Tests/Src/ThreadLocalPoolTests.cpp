@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <list>
+#include <thread>
+#include <vector>
+
+#include "Utilities/ThreadLocalPool.hpp"
+
+TEST(ThreadLocalPoolTests, WhenFreedOnSameThreadShouldReuseBlock)
+{
+    auto* first = Utilities::ThreadLocalPool::allocate(40);
+    Utilities::ThreadLocalPool::deallocate(first, 40);
+
+    auto* second = Utilities::ThreadLocalPool::allocate(48);  // same 64 byte class
+    EXPECT_EQ(first, second);
+    Utilities::ThreadLocalPool::deallocate(second, 48);
+
+    // large and over-aligned requests bypass the slabs
+    auto* large = Utilities::ThreadLocalPool::allocate(4096, 64);
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(large) % 64);
+    Utilities::ThreadLocalPool::deallocate(large, 4096, 64);
+}
+
+TEST(ThreadLocalPoolTests, WhenFreedByAnotherThreadShouldReturnToOwner)
+{
+    std::jthread owner(
+        []()
+        {
+            auto* block = Utilities::ThreadLocalPool::allocate(200);
+
+            std::jthread([block]() noexcept
+                         {
+                             Utilities::ThreadLocalPool::deallocate(block, 200);
+                             Utilities::ThreadLocalPool::flush();
+                         })
+                .join();
+
+            // free lists inherited from an adopted heap drain first, the returned block follows
+            std::vector<void*> taken;
+            bool reused = false;
+            for (size_t i = 0; i < Utilities::ThreadLocalPool::slab_size && !reused; ++i)
+            {
+                taken.push_back(Utilities::ThreadLocalPool::allocate(200));
+                reused = taken.back() == block;
+            }
+
+            EXPECT_TRUE(reused);
+            for (auto* memory : taken)
+                Utilities::ThreadLocalPool::deallocate(memory, 200);
+        });
+}
+
+TEST(ThreadLocalPoolTests, WhenFreedByThreadThatNeverAllocatedShouldBatchTheReturn)
+{
+    // a size class of its own, so the blocks taken here never pile up in the other tests' lists
+    constexpr size_t bytes = 1000;
+
+    std::jthread owner(
+        []()
+        {
+            std::vector<void*> blocks;
+            for (int i = 0; i < 8; ++i)
+                blocks.push_back(Utilities::ThreadLocalPool::allocate(bytes));
+
+            std::promise<void> freed;
+            std::promise<void> checked;
+            std::jthread freer(
+                [&blocks, &freed, flush_now = checked.get_future()]() mutable noexcept
+                {
+                    for (auto* block : blocks)
+                        Utilities::ThreadLocalPool::deallocate(block, bytes);
+
+                    freed.set_value();
+                    flush_now.wait();
+                    Utilities::ThreadLocalPool::flush();
+                });
+            freed.get_future().wait();
+
+            std::vector<void*> taken;
+            const auto take_until_returned = [&blocks, &taken]()
+            {
+                for (size_t i = 0; i < 1024; ++i)
+                {
+                    taken.push_back(Utilities::ThreadLocalPool::allocate(bytes));
+                    if (std::find(blocks.begin(), blocks.end(), taken.back()) != blocks.end())
+                        return true;
+                }
+                return false;
+            };
+
+            // fewer than remote_batch blocks, they wait in the freeing thread's batch
+            EXPECT_FALSE(take_until_returned());
+
+            checked.set_value();
+            freer.join();
+            EXPECT_TRUE(take_until_returned());
+
+            for (auto* memory : taken)
+                Utilities::ThreadLocalPool::deallocate(memory, bytes);
+        });
+}
+
+TEST(ThreadLocalPoolTests, WhenUsedAsContainerAllocatorShouldBehaveLikeStd)
+{
+    std::list<int, Utilities::PoolAllocator<int>> values;
+    for (int i = 0; i < 1000; ++i)
+        values.push_back(i);
+
+    ASSERT_EQ(1000U, values.size());
+    EXPECT_EQ(999, values.back());
+
+    // nodes freed on a thread that doesn't own them
+    std::thread(
+        [&values]() noexcept
+        {
+            values.clear();
+            Utilities::ThreadLocalPool::flush();
+        })
+        .join();
+
+    values.push_back(1000);
+    EXPECT_EQ(1000, values.front());
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Utilities/ThreadPool.hpp"
@@ -25,3 +30,255 @@ TEST(ThreadPoolTests, WhenMultipleTasksSubmittedShouldPreserveAllResults)
     EXPECT_EQ("one", results[0].get());
     EXPECT_EQ("two", results[1].get());
 }
+
+TEST(ThreadPoolTests, WhenTracingEnabledShouldRecordLabelledTasks)
+{
+    Utilities::ThreadPool pool(2);
+    pool.enable_tracing();
+
+    auto labelled = pool.submit({.label = "labelled"}, []() noexcept { return 1; });
+    auto anonymous = pool.submit([]() noexcept { return 2; });
+
+    EXPECT_EQ(1, labelled.get());
+    EXPECT_EQ(2, anonymous.get());
+
+    ASSERT_NE(nullptr, pool.task_tracer());
+
+    // the span is recorded right after the result is published
+    std::string trace;
+    for (int attempt = 0; attempt < 1000 && trace.find("\"name\":\"task\"") == std::string::npos; ++attempt)
+    {
+        std::ostringstream out;
+        pool.task_tracer()->flush(out);
+        trace += out.str();
+        std::this_thread::yield();
+    }
+
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"labelled\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"task\""));
+}
+
+TEST(ThreadPoolTests, WhenWorkerBusyShouldRunHigherPriorityTasksFirst)
+{
+    Utilities::ThreadPool pool(
+        Utilities::ThreadPoolOptions{.workers = 1, .starvation_threshold = std::chrono::hours(1)});
+    std::promise<void> gate;
+    std::vector<std::string> order;
+
+    auto blocker = pool.submit([opened = gate.get_future().share()]() noexcept { opened.wait(); });
+    auto background = pool.submit({.priority = Utilities::TaskPriority::Background},
+                                  [&order]() { order.emplace_back("background"); });
+    auto normal = pool.submit([&order]() { order.emplace_back("normal"); });
+    auto high = pool.submit({.priority = Utilities::TaskPriority::High}, [&order]() { order.emplace_back("high"); });
+
+    gate.set_value();
+    background.get();
+    normal.get();
+    high.get();
+
+    EXPECT_EQ((std::vector<std::string>{"high", "normal", "background"}), order);
+}
+
+TEST(ThreadPoolTests, WhenLowerClassStarvedShouldAgeItAheadOfHigherClasses)
+{
+    Utilities::ThreadPool pool(
+        Utilities::ThreadPoolOptions{.workers = 1, .starvation_threshold = std::chrono::microseconds(0)});
+    std::promise<void> gate;
+    std::vector<std::string> order;
+
+    auto blocker = pool.submit([opened = gate.get_future().share()]() noexcept { opened.wait(); });
+    auto background = pool.submit({.priority = Utilities::TaskPriority::Background},
+                                  [&order]() { order.emplace_back("background"); });
+    auto high = pool.submit({.priority = Utilities::TaskPriority::High}, [&order]() { order.emplace_back("high"); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    gate.set_value();
+    background.get();
+    high.get();
+
+    EXPECT_EQ((std::vector<std::string>{"background", "high"}), order);
+}
+
+TEST(ThreadPoolTests, WhenTimerSubmittedShouldRunOnPoolAfterDelay)
+{
+    Utilities::ThreadPool pool(1);
+    std::promise<std::thread::id> fired;
+
+    const auto scheduled = std::chrono::steady_clock::now();
+    auto handle = pool.submit_after(std::chrono::milliseconds(2),
+                                    [&fired]() noexcept { fired.set_value(std::this_thread::get_id()); });
+
+    EXPECT_TRUE(handle.valid());
+    EXPECT_NE(std::this_thread::get_id(), fired.get_future().get());
+    EXPECT_GE(std::chrono::steady_clock::now() - scheduled, std::chrono::milliseconds(2));
+    EXPECT_FALSE(handle.cancel());
+}
+
+TEST(ThreadPoolTests, WhenPeriodicTimerOutlastsPeriodShouldNotOverlapItself)
+{
+    Utilities::ThreadPool pool(Utilities::ThreadPoolOptions{.workers = 4,
+                                                            .timer_resolution = std::chrono::microseconds(100)});
+    std::atomic<int> running{0};
+    std::atomic<int> overlaps{0};
+    std::atomic<int> runs{0};
+
+    auto handle = pool.submit_every(std::chrono::microseconds(200),
+                                    [&running, &overlaps, &runs]() noexcept
+                                    {
+                                        if (running.fetch_add(1) != 0)
+                                            ++overlaps;
+                                        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                                        running.fetch_sub(1);
+                                        ++runs;
+                                    });
+
+    while (runs.load() < 5)
+        std::this_thread::yield();
+    handle.cancel();
+
+    EXPECT_EQ(0, overlaps.load());
+}
+
+TEST(ThreadPoolTests, WhenPinnedToTopologyShouldRunTasks)
+{
+    Utilities::ThreadPool pool(Utilities::ThreadPoolOptions{.workers = 2, .pin_to_topology = true});
+
+    auto outer = pool.submit(
+        [&pool]()
+        {
+            // submitted from a worker, lands in the worker's own domain
+            return pool.submit([]() noexcept { return 21; });
+        });
+
+    EXPECT_EQ(21, outer.get().get());
+}
+
+TEST(ThreadPoolTests, WhenPinnedWithFewerWorkersThanCpusShouldOnlyCreateServedDomains)
+{
+    // a single worker sits in a single L3 domain, whatever the machine has
+    Utilities::ThreadPool pool(Utilities::ThreadPoolOptions{.workers = 1, .pin_to_topology = true});
+    EXPECT_EQ(1U, pool.cache_domains());
+
+    std::vector<Utilities::AsyncResult<int>> results;
+    for (int i = 0; i < 8; ++i)
+        results.push_back(pool.submit([i]() noexcept { return i; }));
+
+    for (int i = 0; i < 8; ++i)
+        EXPECT_EQ(i, results[static_cast<size_t>(i)].get());
+}
+
+TEST(ThreadPoolTests, WhenCpuSetEmptyShouldRejectOptions)
+{
+    EXPECT_THROW(Utilities::ThreadPool(Utilities::ThreadPoolOptions{.workers = 2, .cpu_sets = {{0}, {}}}),
+                 std::invalid_argument);
+}
+
+TEST(ThreadPoolTests, WhenElasticWorkerCannotBePinnedShouldSkipItAndKeepGrowing)
+{
+    // the second cpu set names a cpu no machine has: the first added worker fails to pin,
+    // the supervisor survives that and the next one wraps around onto cpu 0
+    Utilities::ThreadPool pool(Utilities::ThreadPoolOptions{.workers = 1,
+                                                            .max_workers = 2,
+                                                            .scale_up_wait = std::chrono::microseconds(100),
+                                                            .resize_cooldown = std::chrono::milliseconds(1),
+                                                            .cpu_sets = {{0}, {1u << 20}}});
+
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    std::vector<Utilities::AsyncResult<void>> blocked;
+    for (int i = 0; i < 2; ++i)
+        blocked.push_back(pool.submit([opened]() noexcept { opened.wait(); }));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pool.size() < 2 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(2U, pool.size());
+
+    gate.set_value();
+    for (auto& result : blocked)
+        result.get();
+}
+
+TEST(ThreadPoolTests, WhenElasticPoolBlockedShouldGrowAndShrinkBackWhenIdle)
+{
+    Utilities::ThreadPool pool(Utilities::ThreadPoolOptions{.workers = 1,
+                                                            .max_workers = 3,
+                                                            .scale_up_wait = std::chrono::microseconds(500),
+                                                            .idle_timeout = std::chrono::milliseconds(20),
+                                                            .resize_cooldown = std::chrono::milliseconds(1)});
+    EXPECT_EQ(1U, pool.size());
+
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    std::vector<Utilities::AsyncResult<void>> blocked;
+    for (int i = 0; i < 3; ++i)
+        blocked.push_back(pool.submit([opened]() noexcept { opened.wait(); }));
+
+    // every task blocks its worker, so the queue only drains if the pool grows
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pool.size() < 3 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(3U, pool.size());
+
+    gate.set_value();
+    for (auto& result : blocked)
+        result.get();
+
+    while (pool.size() > 1 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(1U, pool.size());
+}
+
+TEST(ThreadPoolTests, WhenJoinedWithDrainShouldRunEveryQueuedTask)
+{
+    Utilities::ThreadPool pool(2);
+    std::atomic<int> completed{0};
+
+    for (int i = 0; i < 100; ++i)
+        pool.post(
+            [&pool, &completed]() noexcept
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                pool.post([&completed]() noexcept { ++completed; });  // queued while draining
+                ++completed;
+            });
+
+    pool.join(Utilities::ShutdownPolicy::Drain);
+
+    EXPECT_EQ(200, completed.load());
+    EXPECT_EQ(0U, pool.size());
+}
+
+TEST(ThreadPoolTests, WhenElasticPoolDrainedWhileWorkersRetireShouldJoin)
+{
+    // the grown pool's workers go idle and try to retire while join( ) drains, neither may wait on the other
+    for (int round = 0; round < 20; ++round)
+    {
+        Utilities::ThreadPool pool(Utilities::ThreadPoolOptions{.workers = 1,
+                                                                .max_workers = 3,
+                                                                .scale_up_wait = std::chrono::microseconds(100),
+                                                                .idle_timeout = std::chrono::microseconds(1),
+                                                                .resize_cooldown = std::chrono::microseconds(1)});
+
+        std::promise<void> gate;
+        std::shared_future<void> opened = gate.get_future().share();
+        std::atomic<int> completed{0};
+        for (int i = 0; i < 3; ++i)
+            pool.post(
+                [opened, &completed]() noexcept
+                {
+                    opened.wait();
+                    ++completed;
+                });
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (pool.size() < 3 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+        gate.set_value();
+        pool.join(Utilities::ShutdownPolicy::Drain);
+
+        EXPECT_EQ(3, completed.load());
+        EXPECT_EQ(0U, pool.size());
+    }
+}
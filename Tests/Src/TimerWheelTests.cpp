@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "Utilities/FunctionWrapper.hpp"
+#include "Utilities/TimerWheel.hpp"
+
+namespace
+{
+    // runs expired timers right on the timer thread
+    void run_inline(Utilities::FunctionWrapper&& task)
+    {
+        task();
+    }
+}  // namespace
+
+TEST(TimerWheelTests, WhenDelayElapsedShouldDispatchOnceAndNotEarly)
+{
+    Utilities::TimerWheel wheel(run_inline, std::chrono::microseconds(100));
+    std::promise<std::chrono::steady_clock::time_point> fired;
+
+    const auto scheduled = std::chrono::steady_clock::now();
+    wheel.schedule_after(std::chrono::milliseconds(5),
+                         [&fired]() { fired.set_value(std::chrono::steady_clock::now()); });
+
+    EXPECT_GE(fired.get_future().get() - scheduled, std::chrono::milliseconds(5));
+    EXPECT_EQ(0U, wheel.pending());
+}
+
+TEST(TimerWheelTests, WhenDelaySpansSeveralLevelsShouldCascadeAndFire)
+{
+    // 300 ticks only fits the second level of the wheel
+    Utilities::TimerWheel wheel(run_inline, std::chrono::microseconds(10));
+    std::promise<void> fired;
+
+    wheel.schedule_after(std::chrono::microseconds(3000), [&fired]() { fired.set_value(); });
+
+    EXPECT_EQ(std::future_status::ready, fired.get_future().wait_for(std::chrono::seconds(5)));
+}
+
+TEST(TimerWheelTests, WhenCancelledShouldNotFire)
+{
+    Utilities::TimerWheel wheel(run_inline, std::chrono::microseconds(100));
+    std::atomic<int> runs{0};
+
+    auto handle = wheel.schedule_after(std::chrono::milliseconds(2), [&runs]() { ++runs; });
+
+    EXPECT_TRUE(handle.cancel());
+    EXPECT_FALSE(handle.cancel());
+    EXPECT_EQ(0U, wheel.pending());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(0, runs.load());
+}
+
+TEST(TimerWheelTests, WhenPeriodicTimerCancelledShouldStopRepeating)
+{
+    Utilities::TimerWheel wheel(run_inline, std::chrono::microseconds(100));
+    std::atomic<int> runs{0};
+
+    auto handle = wheel.schedule_every(std::chrono::microseconds(500), [&runs]() { ++runs; });
+
+    while (runs.load() < 3)
+        std::this_thread::yield();
+
+    EXPECT_TRUE(handle.cancel());
+    const auto after_cancel = runs.load();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    EXPECT_LE(runs.load(), after_cancel + 1);  // one run may already be in flight
+}